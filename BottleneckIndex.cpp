@@ -0,0 +1,120 @@
+/**
+ * BottleneckIndex.cpp
+ *
+ *  Programmer: Richard Caaya
+ */
+
+#include "BottleneckIndex.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <stdexcept>
+
+#include "ThreadPool.h"
+
+namespace Algorithms
+{
+	static const size_t QUERY_GRAIN = 4096;		// queries a thread takes at a time
+
+	static int findRoot(std::vector<int>& parent, int v) {
+		while (parent[v] != v) {
+			parent[v] = parent[parent[v]];
+			v = parent[v];
+		}
+		return v;
+	}
+
+	BottleneckIndex::BottleneckIndex(const std::vector<Edge<int>*>& forest, int V) : V(V) {
+		// (weight, x, y) of every edge, lightest first
+		std::vector<std::pair<double, std::pair<int, int> > > sorted;
+		sorted.reserve(forest.size());
+		for (const Edge<int>* e : forest) {
+			int x = e->getX()->getValue(), y = e->getY()->getValue();
+			if (x < 0 || x >= V || y < 0 || y >= V)
+				throw std::invalid_argument("Forest edge end-point out of range");
+			sorted.push_back(std::make_pair(e->getWeight(), std::make_pair(x, y)));
+		}
+		std::sort(sorted.begin(), sorted.end());
+
+		// Kruskal reconstruction tree: children always have smaller ids than their parent
+		std::vector<int> sets(V), top(V);			// top[root of a set] = the tree node standing for it
+		for (int v = 0; v < V; ++v)
+			sets[v] = top[v] = v;
+		std::vector<int> left, right;
+		left.reserve(sorted.size());
+		right.reserve(sorted.size());
+		weight.reserve(sorted.size());
+
+		Node leaf = { -1, 0, 0 };
+		nodes.reserve(V + sorted.size());
+		nodes.assign(V, leaf);
+		for (size_t i = 0; i < sorted.size(); ++i) {
+			int rx = findRoot(sets, sorted[i].second.first), ry = findRoot(sets, sorted[i].second.second);
+			if (rx == ry)
+				throw std::invalid_argument("The edges contain a cycle");
+
+			int n = (int) nodes.size();
+			nodes[top[rx]].parent = n;
+			nodes[top[ry]].parent = n;
+			left.push_back(top[rx]);
+			right.push_back(top[ry]);
+			weight.push_back(sorted[i].first);
+			nodes.push_back(leaf);
+
+			sets[rx] = ry;
+			top[ry] = n;
+		}
+
+		// subtree sizes bottom-up, then heavy chains and depths top-down
+		const int N = (int) nodes.size();
+		std::vector<int> size(N, 1);
+		for (int n = V; n < N; ++n)
+			size[n] = size[left[n - V]] + size[right[n - V]];
+
+		for (int n = N - 1; n >= 0; --n) {
+			if (nodes[n].parent < 0) {
+				nodes[n].head = n;
+				nodes[n].depth = 0;
+			}
+			if (n < V)
+				continue;
+			int heavy = left[n - V], light = right[n - V];
+			if (size[light] > size[heavy])
+				std::swap(heavy, light);
+			nodes[heavy].head = nodes[n].head;
+			nodes[light].head = light;
+			nodes[heavy].depth = nodes[light].depth = nodes[n].depth + 1;
+		}
+	}
+
+	double BottleneckIndex::bottleneck(int u, int v) const {
+		assert(u >= 0 && u < V);
+		assert(v >= 0 && v < V);
+
+		if (u == v)
+			return 0.0;
+
+		// climb chain by chain until both are on the chain of their common ancestor
+		while (nodes[u].head != nodes[v].head) {
+			if (nodes[nodes[u].head].depth < nodes[nodes[v].head].depth)
+				std::swap(u, v);
+			u = nodes[nodes[u].head].parent;
+			if (u < 0)
+				return std::numeric_limits<double>::infinity();	// different trees
+		}
+		int ancestor = (nodes[u].depth < nodes[v].depth) ? u : v;
+		return weight[ancestor - V];
+	}
+
+	std::vector<double> BottleneckIndex::bottlenecks(const std::vector<std::pair<int, int> >& queries, unsigned int threads) const {
+		std::vector<double> answers(queries.size());
+
+		auto worker = [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+				answers[i] = bottleneck(queries[i].first, queries[i].second);
+		};
+		ThreadPool::shared().parallelFor(0, queries.size(), QUERY_GRAIN, worker, threads);
+		return answers;
+	}
+}
@@ -0,0 +1,80 @@
+#ifndef BOTTLENECKINDEX_H_
+#define BOTTLENECKINDEX_H_
+
+#include <utility>
+#include <vector>
+
+#include "Edge.h"
+
+namespace Algorithms
+{
+	/**
+	 * The {@code BottleneckIndex} class answers bottleneck (minimax) path
+	 * queries: the smallest possible weight of the heaviest edge on a path
+	 * between two vertices. In a minimum spanning forest that is the
+	 * heaviest edge on the unique forest path, so the index is built from
+	 * <code>MST::edges()</code>.
+	 *
+	 * The forest is turned into its Kruskal reconstruction tree: its edges
+	 * are added lightest first, and each one becomes a new internal node
+	 * whose children are the trees it joins. The vertices are the leaves,
+	 * and the bottleneck between two vertices is the weight of their lowest
+	 * common ancestor. The ancestor is found by heavy-light decomposition,
+	 * which crosses at most log2(V) chains, so a query takes O(log V) time
+	 * and the index takes O(V) memory.
+	 *
+	 * @programmer Richard Caaya
+	 */
+	class BottleneckIndex
+	{
+	public:
+
+		/**
+		 * Builds the index of a minimum spanning forest.
+		 *
+		 * @param forest the edges of the forest, e.g. <code>MST::edges()</code>
+		 * @param V the number of vertices
+		 * @throws <code>std::invalid_argument</code> if an edge has an
+		 *         end-point outside [0, V) or the edges contain a cycle
+		 */
+		BottleneckIndex(const std::vector<Edge<int>*>& forest, int V);
+
+		/**
+		 * Returns the number of vertices.
+		 * @return the number of vertices
+		 */
+		inline int getV() const { return this->V; }
+
+		/**
+		 * Returns the weight of the heaviest edge on the forest path between u and v.
+		 *
+		 * @param u a vertex
+		 * @param v a vertex
+		 * @return the bottleneck weight, 0 if u == v, and infinity if u and
+		 *         v are in different trees
+		 */
+		double bottleneck(int u, int v) const;
+
+		/**
+		 * Answers many queries at once, split across threads.
+		 *
+		 * @param queries the (u, v) pairs to answer
+		 * @param threads the most threads to use (0 = all of <code>ThreadPool::shared()</code>)
+		 * @return bottleneck(u, v) for every pair, in the same order
+		 */
+		std::vector<double> bottlenecks(const std::vector<std::pair<int, int> >& queries, unsigned int threads = 0) const;
+
+	private:
+		struct Node {
+			int parent;			// -1 for a root
+			int head;			// top of the heavy chain holding this node
+			int depth;
+		};
+
+		int V;
+		std::vector<Node> nodes;		// leaves 0 .. V - 1 are the vertices, then one node per forest edge
+		std::vector<double> weight;		// weight[n - V] = weight of the edge that made internal node n
+	};
+}
+
+#endif /* BOTTLENECKINDEX_H_ */
@@ -0,0 +1,138 @@
+/**
+ * BoundedQueue.h
+ *
+ *  Programmer Richard Caaya
+ *
+ */
+
+#ifndef BOUNDEDQUEUE_H_
+#define BOUNDEDQUEUE_H_
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <thread>
+
+namespace Algorithms
+{
+	/**
+	 *	This class models a fixed-capacity FIFO queue that any number of
+	 *	threads may push to and pop from without locks. Every slot carries a
+	 *	sequence number that tells producers and consumers whether it is
+	 *	free or full for their lap around the ring, so each operation is a
+	 *	single compare-and-swap on the head or tail counter.
+	 *
+	 *	@see http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+	 */
+	template <typename T>
+	class BoundedQueue
+	{
+	public:
+
+		/**
+		 * Initializes a new empty queue
+		 * @param capacity the maximum number of elements, rounded up to a power of two
+		 */
+		BoundedQueue(size_t capacity) : mask(roundUp(capacity) - 1), slots(mask + 1), head(0), tail(0) {
+			for (size_t i = 0; i <= mask; i++)
+				slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		/**
+		 * Adds element to the back of the queue if there is room
+		 * @param element the element to be added
+		 * @return <code>true</code> if it was added and <code>false</code> if the queue is full
+		 */
+		bool tryPush(const T& element) {
+			size_t pos = tail.load(std::memory_order_relaxed);
+			for (;;) {
+				Slot& slot = slots[pos & mask];
+				size_t sequence = slot.sequence.load(std::memory_order_acquire);
+				ptrdiff_t diff = (ptrdiff_t) sequence - (ptrdiff_t) pos;
+				if (diff == 0) {
+					if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+						slot.value = element;
+						slot.sequence.store(pos + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (diff < 0) {
+					return false;
+				}
+				else {
+					pos = tail.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		/**
+		 * Removes the element at the front of the queue if there is one
+		 * @param element receives the removed element
+		 * @return <code>true</code> if an element was removed and <code>false</code> if the queue is empty
+		 */
+		bool tryPop(T& element) {
+			size_t pos = head.load(std::memory_order_relaxed);
+			for (;;) {
+				Slot& slot = slots[pos & mask];
+				size_t sequence = slot.sequence.load(std::memory_order_acquire);
+				ptrdiff_t diff = (ptrdiff_t) sequence - (ptrdiff_t) (pos + 1);
+				if (diff == 0) {
+					if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+						element = slot.value;
+						slot.sequence.store(pos + mask + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (diff < 0) {
+					return false;
+				}
+				else {
+					pos = head.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		/**
+		 * Adds element to the back of the queue, yielding while it is full
+		 * @param element the element to be added
+		 */
+		void push(const T& element) {
+			while (!tryPush(element))
+				std::this_thread::yield();
+		}
+
+		/**
+		 * Removes the element at the front of the queue, yielding while it is empty
+		 * @return the removed element
+		 */
+		T pop() {
+			T element;
+			while (!tryPop(element))
+				std::this_thread::yield();
+			return element;
+		}
+
+	private:
+
+		static size_t roundUp(size_t n) {
+			size_t p = 2;
+			while (p < n)
+				p <<= 1;
+			return p;
+		}
+
+		struct Slot {
+			std::atomic<size_t> sequence;
+			T value;
+
+			Slot() : sequence(0), value() {}
+		};
+
+		const size_t mask;
+		std::vector<Slot> slots;
+		alignas(64) std::atomic<size_t> head;	// next slot to pop
+		alignas(64) std::atomic<size_t> tail;	// next slot to push
+	};
+}
+
+#endif /* BOUNDEDQUEUE_H_ */
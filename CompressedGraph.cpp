@@ -0,0 +1,328 @@
+/**
+ * CompressedGraph.cpp
+ *
+ *  Programmer: Richard Caaya
+ */
+
+#include "CompressedGraph.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <utility>
+#include <limits>
+
+namespace Algorithms
+{
+	static const size_t MAX_DICTIONARY_SIZE = 1 << 16;
+	static const size_t READ_CHUNK = 1 << 20;		// bytes read from a file at a time
+
+	/**
+	 * Reads the whitespace-separated tokens of a file a chunk at a time
+	 */
+	class TokenReader {
+	public:
+		explicit TokenReader(const std::string& filename) :
+			in(filename.c_str(), std::ios::binary), buffer(READ_CHUNK + 1), begin(0), end(0), atEnd(false) {}
+
+		bool isOpen() const { return in.is_open(); }
+
+		/**
+		 * Returns the next token, NUL-terminated and valid until the next
+		 * call, or NULL at the end of the file
+		 */
+		const char* next() {
+			for (;;) {
+				while (begin < end && std::isspace((unsigned char) buffer[begin]))
+					++begin;
+				size_t stop = begin;
+				while (stop < end && !std::isspace((unsigned char) buffer[stop]))
+					++stop;
+
+				if (stop < end || (atEnd && stop > begin)) {
+					buffer[stop] = '\0';
+					const char* token = &buffer[begin];
+					begin = std::min(stop + 1, end);
+					return token;
+				}
+				if (atEnd)
+					return NULL;
+
+				// keep the unfinished token and read more after it
+				size_t partial = end - begin;
+				if (partial + 1 == buffer.size())
+					buffer.resize(2 * buffer.size());
+				std::memmove(&buffer[0], &buffer[begin], partial);
+				begin = 0;
+				in.read(&buffer[partial], buffer.size() - 1 - partial);
+				end = partial + in.gcount();
+				atEnd = !in;
+			}
+		}
+
+	private:
+		std::ifstream in;
+		std::vector<char> buffer;		// one byte more than is read, for the NUL after a last token
+		size_t begin;
+		size_t end;
+		bool atEnd;
+	};
+
+	/**
+	 * The edges of a graph
+	 */
+	struct GraphEdges {
+		const Graph& graph;
+
+		template <typename Visitor>
+		void operator()(Visitor visit) const {
+			for (int x = 0; x < graph.getV(); ++x)
+				graph.forEachNeighbor(x, [&visit, x](int y, double w) { visit(x, y, w); });
+		}
+	};
+
+	/**
+	 * The edges of a file, read again on every call
+	 */
+	struct FileEdges {
+		std::string filename;
+		int V;
+
+		template <typename Visitor>
+		void operator()(Visitor visit) const {
+			TokenReader reader(filename);
+			reader.next();				// V
+			for (;;) {
+				const char* token = reader.next();
+				if (token == NULL)
+					return;
+				long x = std::strtol(token, NULL, 10);
+				if ((token = reader.next()) == NULL)
+					return;
+				long y = std::strtol(token, NULL, 10);
+				if ((token = reader.next()) == NULL)
+					return;
+				double w = std::strtod(token, NULL);
+
+				if (x >= 0 && x < V && y >= 0 && y < V)
+					visit((int) x, (int) y, w);
+			}
+		}
+	};
+
+	CompressedGraph::CompressedGraph(const Graph& graph) :
+			V(graph.getV()),
+			E(0),
+			codeBytes(1),
+			quantised(false),
+			minWeight(0.0),
+			step(0.0) {
+
+		GraphEdges edges = { graph };
+		build(edges);
+	}
+
+	CompressedGraph::CompressedGraph(const std::string& filename) :
+			V(0),
+			E(0),
+			codeBytes(1),
+			quantised(false),
+			minWeight(0.0),
+			step(0.0) {
+
+		TokenReader reader(filename);
+		if (!reader.isOpen()) {
+			std::cout << "File: " << filename << " not found! Aborting!" << std::endl;
+			exit(0);
+		}
+		const char* token = reader.next();
+		V = (token == NULL) ? 0 : std::strtol(token, NULL, 10);
+
+		FileEdges edges = { filename, V };
+		build(edges);
+	}
+
+	template <typename Edges>
+	void CompressedGraph::build(const Edges& edges) {
+		// first pass: the weight coding, and the size of every row with each
+		// neighbor stored as its zigzag distance from the vertex
+		std::vector<uint32_t> above(V, 0), below(V, 0);
+		std::vector<uint64_t> next(V + 1, 0);		// next[x + 1] = bytes of row x, then where its next edge goes
+		double maxWeight = -std::numeric_limits<double>::infinity();
+		minWeight = std::numeric_limits<double>::infinity();
+		bool fits = true;
+		edges([&](int x, int y, double w) {
+			if (y >= x)
+				above[x]++;
+			else
+				below[x]++;
+			next[x + 1] += varintSize(zigzag(y - x));
+
+			minWeight = std::min(minWeight, w);
+			maxWeight = std::max(maxWeight, w);
+			if (fits) {
+				dictionary.push_back(w);
+				if (dictionary.size() > 2 * MAX_DICTIONARY_SIZE) {
+					std::sort(dictionary.begin(), dictionary.end());
+					dictionary.erase(std::unique(dictionary.begin(), dictionary.end()), dictionary.end());
+					fits = dictionary.size() <= MAX_DICTIONARY_SIZE;
+				}
+			}
+		});
+
+		// pick the weight coding: a dictionary if the distinct weights fit in 16 bits
+		std::sort(dictionary.begin(), dictionary.end());
+		dictionary.erase(std::unique(dictionary.begin(), dictionary.end()), dictionary.end());
+		fits = fits && dictionary.size() <= MAX_DICTIONARY_SIZE;
+
+		if (!fits) {
+			std::vector<double>().swap(dictionary);
+			quantised = true;
+			codeBytes = 2;
+			step = (maxWeight - minWeight) / (MAX_DICTIONARY_SIZE - 1);
+		}
+		else if (dictionary.size() > 256) {
+			codeBytes = 2;
+		}
+
+		// lay the rows out back to back, each starting with room for its two counts
+		for (int x = 0; x < V; ++x) {
+			next[x + 1] += (uint64_t) (above[x] + below[x]) * codeBytes;
+			next[x + 1] += next[x] + varintSize(above[x]) + varintSize(below[x]);
+		}
+		data.resize(next[V]);
+		for (int x = V - 1; x >= 0; --x)
+			next[x + 1] = next[x] + varintSize(above[x]) + varintSize(below[x]);
+		next[0] = 0;
+
+		// second pass: each edge goes after the ones of its row seen so far
+		edges([&](int x, int y, double w) {
+			uint8_t* p = &data[0] + next[x + 1];
+			writeVarint(p, zigzag(y - x));
+
+			uint32_t code;
+			if (quantised) {
+				code = (step > 0.0) ? (uint32_t) ((w - minWeight) / step + 0.5) : 0;
+			}
+			else {
+				code = std::lower_bound(dictionary.begin(), dictionary.end(), w) - dictionary.begin();
+			}
+			writeCode(p, code);
+			next[x + 1] = p - &data[0];
+		});
+
+		// sort and encode each row in place, then close the gaps: no gap in
+		// the encoding is longer than the distance it replaces, so a row never
+		// outgrows its slot and is written at or before where it was read
+		typedef std::pair<int, uint32_t> Neighbor;		// (y, weight code)
+		std::vector<Neighbor> neighbors;
+		blockOffsets.reserve((V + COMPRESSED_BLOCK_SIZE - 1) / COMPRESSED_BLOCK_SIZE);
+		uint64_t size = 0;
+		E = 0;
+		for (int x = 0; x < V; ++x) {
+			const uint8_t* p = &data[0] + next[x] + varintSize(above[x]) + varintSize(below[x]);
+			neighbors.clear();
+			for (uint32_t i = 0; i < above[x] + below[x]; ++i) {
+				int y = x + unzigzag(readVarint(p));
+				neighbors.push_back(std::make_pair(y, readCode(p)));
+			}
+			std::stable_sort(neighbors.begin(), neighbors.end(),
+					[](const Neighbor& a, const Neighbor& b) { return a.first < b.first; });
+			neighbors.erase(std::unique(neighbors.begin(), neighbors.end(),
+					[](const Neighbor& a, const Neighbor& b) { return a.first == b.first; }), neighbors.end());
+
+			size_t split = 0;			// neighbors[split..] are the ones >= x
+			while (split < neighbors.size() && neighbors[split].first < x)
+				split++;
+
+			if (x % COMPRESSED_BLOCK_SIZE == 0)
+				blockOffsets.push_back(size);
+
+			uint8_t* out = &data[0] + size;
+			writeVarint(out, neighbors.size() - split);
+			writeVarint(out, split);
+			int previous = x;
+			for (size_t i = split; i < neighbors.size(); ++i) {
+				writeVarint(out, neighbors[i].first - previous);
+				previous = neighbors[i].first;
+				writeCode(out, neighbors[i].second);
+			}
+			previous = x;
+			for (size_t i = split; i-- > 0; ) {
+				writeVarint(out, previous - neighbors[i].first);
+				previous = neighbors[i].first;
+				writeCode(out, neighbors[i].second);
+			}
+
+			size = out - &data[0];
+			E += neighbors.size();
+		}
+
+		// drop the slack, unless copying the rows would cost more than it saves
+		data.resize(size);
+		if (data.capacity() - size > size / 8)
+			std::vector<uint8_t>(data).swap(data);
+		std::vector<double>(dictionary).swap(dictionary);
+	}
+
+	const uint8_t* CompressedGraph::row(int x) const {
+		assert(x >= 0 && x < V);
+
+		const uint8_t* p = &data[0] + blockOffsets[x / COMPRESSED_BLOCK_SIZE];
+		for (int skip = x % COMPRESSED_BLOCK_SIZE; skip > 0; --skip) {
+			uint32_t degree = readVarint(p);
+			degree += readVarint(p);
+			for (uint32_t i = 0; i < degree; ++i) {
+				while (*p++ & 0x80) {}		// the gap
+				p += codeBytes;				// the weight
+			}
+		}
+		return p;
+	}
+
+	bool CompressedGraph::isAdjacent(int x, int y) const {
+		const uint8_t* p = row(x);
+		uint32_t above = readVarint(p);
+		uint32_t below = readVarint(p);
+
+		int z = x;
+		if (y >= x) {
+			for (uint32_t i = 0; i < above; ++i) {
+				z += (int) readVarint(p);
+				if (z >= y)
+					return z == y;		// the run above is ascending
+				p += codeBytes;
+			}
+			return false;
+		}
+
+		for (uint32_t i = 0; i < above; ++i) {
+			while (*p++ & 0x80) {}
+			p += codeBytes;
+		}
+		for (uint32_t i = 0; i < below; ++i) {
+			z -= (int) readVarint(p);
+			if (z <= y)
+				return z == y;			// the run below is descending
+			p += codeBytes;
+		}
+		return false;
+	}
+
+	int CompressedGraph::getDegree(int v) const {
+		const uint8_t* p = row(v);
+		uint32_t above = readVarint(p);
+		return above + readVarint(p);
+	}
+
+	size_t CompressedGraph::memoryUsage() const {
+		return sizeof(*this)
+				+ data.capacity() * sizeof(uint8_t)
+				+ blockOffsets.capacity() * sizeof(uint64_t)
+				+ dictionary.capacity() * sizeof(double);
+	}
+}
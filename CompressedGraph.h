@@ -0,0 +1,211 @@
+#ifndef COMPRESSEDGRAPH_H_
+#define COMPRESSEDGRAPH_H_
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "Graph.h"
+
+namespace Algorithms
+{
+	/**
+	 * Vertices per entry of the block offset table of a <code>CompressedGraph</code>.
+	 */
+	const int COMPRESSED_BLOCK_SIZE = 16;
+
+	/**
+	 *	This class implements a read-only, compressed copy of a
+	 *	<code>Graph</code> for graphs too large to hold as lists, a matrix or
+	 *	even a flat edge array.
+	 *
+	 *  Each row is stored as the number of neighbors at or above the vertex
+	 *  and the number below it, then the neighbors above in ascending order
+	 *  and those below in descending order. Each neighbor is the gap from
+	 *  the previous one (the first of each run from the vertex itself) as a
+	 *  varint, and the weight as a 1- or 2-byte code. Weights are
+	 *  dictionary-coded, and so exact, when the graph has at most 65536
+	 *  distinct weights; otherwise they are quantised to 65536 evenly spaced
+	 *  levels between the smallest and largest weight. An offset every
+	 *  COMPRESSED_BLOCK_SIZE rows gives random access to any vertex.
+	 *
+	 *  A graph can be compressed straight from a file in two passes, so no
+	 *  <code>Graph</code> or edge array is ever built: the first pass sizes
+	 *  every row, the second writes each edge into its row. Every gap in the
+	 *  final encoding is at most the edge's distance from its vertex, so the
+	 *  rows are then sorted and encoded in place. Loading takes the
+	 *  unsorted rows, which are about the compressed size, plus 16 bytes
+	 *  per vertex.
+	 *
+	 *  Rows are decoded on the fly by <code>forEachNeighbor</code>, which
+	 *  is all <code>MST</code> needs.
+	 *
+	 *  @programmer Richard Caaya
+	 */
+	class CompressedGraph
+	{
+	public:
+
+		/**
+		 * Compresses graph. The graph can be released afterwards.
+		 *
+		 * @param graph the graph to compress
+		 */
+		CompressedGraph(const Graph& graph);
+
+		/**
+		 * Compresses the graph in a file in the format read by
+		 * <code>Graph(filename)</code>, reading it twice. A repeated x-y
+		 * keeps its first weight, and edges whose end-points are not in
+		 * [0, V) are ignored.
+		 *
+		 * @param filename The file name of the input data: V, then integer triples (i, j, cost)
+		 */
+		CompressedGraph(const std::string& filename);
+
+		/**
+		 * Returns the number of vertices in this graph.
+		 *
+		 * @return the number of vertices in this graph
+		 */
+		inline int getV() const { return this->V; }
+
+		/**
+		 * Returns the number of edges in this graph.
+		 *
+		 * @return the number of edges in this graph
+		 */
+		inline int getE() const { return this->E; }
+
+		/**
+		 * Returns true if the weights are stored exactly.
+		 *
+		 * @return <code>false</code> if the weights were quantised
+		 */
+		inline bool hasExactWeights() const { return !this->quantised; }
+
+		/**
+		 * Tests whether there is an edge from node x to node y
+		 *
+		 * @param x the node x
+		 * @param y the node y
+		 * @return TRUE if there is an edge from node x to node y,
+		 * 		   and FALSE otherwise
+		 */
+		bool isAdjacent(int x, int y) const;
+
+		/**
+		 * Returns the degree of vertex
+		 * @param v v the vertex
+		 * @return the degree of vertex
+		 */
+		int getDegree(int v) const;
+
+		/**
+		 * Returns the number of bytes used by this graph.
+		 *
+		 * @return the memory footprint in bytes
+		 */
+		size_t memoryUsage() const;
+
+		/**
+		 * Calls visit(y, w) for every edge x-y of weight w: first the
+		 * neighbors y >= x in ascending order, then the others in
+		 * descending order.
+		 *
+		 * @param x the node to enumerate
+		 * @param visit a callable taking (int, double)
+		 */
+		template <typename Visitor>
+		void forEachNeighbor(int x, Visitor visit) const {
+			const uint8_t* p = row(x);
+			uint32_t above = readVarint(p);
+			uint32_t below = readVarint(p);
+			int y = x;
+			for (uint32_t i = 0; i < above; ++i) {
+				y += (int) readVarint(p);
+				visit(y, readWeight(p));
+			}
+			y = x;
+			for (uint32_t i = 0; i < below; ++i) {
+				y -= (int) readVarint(p);
+				visit(y, readWeight(p));
+			}
+		}
+
+	private:
+		int V;
+		int E;
+		int codeBytes;							// bytes per weight code, 1 or 2
+		bool quantised;							// true: weight = minWeight + code * step
+		double minWeight;
+		double step;
+		std::vector<double> dictionary;			// !quantised: weight = dictionary[code]
+		std::vector<uint8_t> data;				// the encoded rows, back to back
+		std::vector<uint64_t> blockOffsets;		// blockOffsets[b] = offset of row b * COMPRESSED_BLOCK_SIZE
+
+		/**
+		 * Returns a pointer to the start of row x
+		 */
+		const uint8_t* row(int x) const;
+
+		inline static uint32_t readVarint(const uint8_t*& p) {
+			uint32_t value = *p & 0x7F;
+			for (int shift = 7; *p++ & 0x80; shift += 7)
+				value |= (uint32_t) (*p & 0x7F) << shift;
+			return value;
+		}
+
+		inline static int unzigzag(uint32_t value) {
+			return (int) (value >> 1) ^ -(int) (value & 1);
+		}
+
+		inline uint32_t readCode(const uint8_t*& p) const {
+			uint32_t code = p[0];
+			if (codeBytes == 2)
+				code |= (uint32_t) p[1] << 8;
+			p += codeBytes;
+			return code;
+		}
+
+		inline double readWeight(const uint8_t*& p) const {
+			uint32_t code = readCode(p);
+			return quantised ? minWeight + code * step : dictionary[code];
+		}
+
+		inline void writeCode(uint8_t*& p, uint32_t code) const {
+			*p++ = code & 0xFF;
+			if (codeBytes == 2)
+				*p++ = code >> 8;
+		}
+
+		inline static void writeVarint(uint8_t*& p, uint32_t value) {
+			while (value >= 0x80) {
+				*p++ = (value & 0x7F) | 0x80;
+				value >>= 7;
+			}
+			*p++ = value;
+		}
+
+		inline static int varintSize(uint32_t value) {
+			int size = 1;
+			for (; value >= 0x80; value >>= 7)
+				size++;
+			return size;
+		}
+
+		inline static uint32_t zigzag(int value) {
+			return ((uint32_t) value << 1) ^ (uint32_t) (value >> 31);
+		}
+
+		/**
+		 * Encodes the graph whose edges edges(visit) passes to visit(x, y, w),
+		 * calling it twice
+		 */
+		template <typename Edges>
+		void build(const Edges& edges);
+	};
+}
+
+#endif /* COMPRESSEDGRAPH_H_ */
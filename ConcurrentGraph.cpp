@@ -0,0 +1,184 @@
+/**
+ * ConcurrentGraph.cpp
+ *
+ *  Programmer: Richard Caaya
+ */
+
+#include "ConcurrentGraph.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace Algorithms
+{
+	const int ConcurrentGraph::ROW_BLOCK;
+
+	ConcurrentGraph::Version::Version(int V) :
+		V(V),
+		E(0),
+		stamp(0),
+		modified(false) {
+
+		assert(V >= 0); // Number of vertices must be positive
+
+		for (int b = 0; b < (V + ROW_BLOCK - 1) / ROW_BLOCK; ++b) {
+			blocks.push_back(std::shared_ptr<Block>(new Block()));
+			blocks.back()->stamp = 0;
+		}
+	}
+
+	ConcurrentGraph::Version::Version(const Version& other, long stamp) :
+		V(other.V),
+		E(other.E),
+		stamp(stamp),
+		modified(false),
+		blocks(other.blocks) {}
+
+	ConcurrentGraph::Version::Row& ConcurrentGraph::Version::writableRow(int x) {
+		std::shared_ptr<Block>& block = blocks[x / ROW_BLOCK];
+		if (block->stamp != stamp) {
+			block.reset(new Block(*block));
+			block->stamp = stamp;
+		}
+
+		std::shared_ptr<Row>& row = block->rows[x % ROW_BLOCK];
+		if (!row) {
+			row.reset(new Row());
+			row->stamp = stamp;
+		}
+		else if (row->stamp != stamp) {
+			row.reset(new Row(*row));
+			row->stamp = stamp;
+		}
+		return *row;
+	}
+
+	std::vector<ConcurrentGraph::Version::Arc>::const_iterator ConcurrentGraph::Version::find(const Row& row, int y) {
+		return std::lower_bound(row.arcs.begin(), row.arcs.end(), y,
+				[](const Arc& arc, int to) { return arc.to < to; });
+	}
+
+	bool ConcurrentGraph::Version::isAdjacent(int x, int y) const {
+		assert(x >= 0 && x < V);
+		assert(y >= 0 && y < V);
+
+		const Row* row = getRow(x);
+		if (row == NULL)
+			return false;
+		std::vector<Arc>::const_iterator arc = find(*row, y);
+		return arc != row->arcs.end() && arc->to == y;
+	}
+
+	double ConcurrentGraph::Version::getEdgeValue(int x, int y) const {
+		assert(x >= 0 && x < V);
+		assert(y >= 0 && y < V);
+
+		const Row* row = getRow(x);
+		if (row != NULL) {
+			std::vector<Arc>::const_iterator arc = find(*row, y);
+			if (arc != row->arcs.end() && arc->to == y)
+				return arc->weight;
+		}
+		return std::numeric_limits<double>::infinity();
+	}
+
+	int ConcurrentGraph::Version::getDegree(int x) const {
+		assert(x >= 0 && x < V);
+
+		const Row* row = getRow(x);
+		return (row == NULL) ? 0 : (int) row->arcs.size();
+	}
+
+	Graph ConcurrentGraph::Version::toGraph(Graph::Representation representation) const {
+		Graph graph(V, representation);
+		for (int x = 0; x < V; ++x)
+			forEachNeighbor(x, [&graph, x](int y, double w) { graph.addEdge(x, y, w); });
+		if (representation == Graph::AUTO)
+			graph.setRepresentation(Graph::AUTO);
+		return graph;
+	}
+
+	bool ConcurrentGraph::Version::addEdge(int x, int y, double w) {
+		if (isAdjacent(x, y))
+			return false;
+
+		Row& row = writableRow(x);
+		Arc arc = { y, w };
+		row.arcs.insert(find(row, y), arc);
+		E++;
+		modified = true;
+		return true;
+	}
+
+	bool ConcurrentGraph::Version::removeEdge(int x, int y) {
+		if (!isAdjacent(x, y))
+			return false;
+
+		Row& row = writableRow(x);
+		row.arcs.erase(find(row, y));
+		if (row.arcs.empty())
+			blocks[x / ROW_BLOCK]->rows[x % ROW_BLOCK].reset();
+		E--;
+		modified = true;
+		return true;
+	}
+
+	bool ConcurrentGraph::Version::setEdgeValue(int x, int y, double v) {
+		if (!isAdjacent(x, y) || getEdgeValue(x, y) == v)
+			return false;
+
+		Row& row = writableRow(x);
+		row.arcs[find(row, y) - row.arcs.begin()].weight = v;
+		modified = true;
+		return true;
+	}
+
+	ConcurrentGraph::ConcurrentGraph(int V) :
+		current(new Version(V)),
+		currentVersion(0) {}
+
+	ConcurrentGraph::ConcurrentGraph(const Graph& graph) :
+		currentVersion(0) {
+
+		std::shared_ptr<Version> first(new Version(graph.getV()));
+		for (int x = 0; x < graph.getV(); ++x) {
+			if (graph.getDegree(x) == 0)
+				continue;
+			Version::Row& row = first->writableRow(x);
+			graph.forEachNeighbor(x, [&row](int y, double w) {
+				Version::Arc arc = { y, w };
+				row.arcs.push_back(arc);
+			});
+			std::sort(row.arcs.begin(), row.arcs.end(),
+					[](const Version::Arc& a, const Version::Arc& b) { return a.to < b.to; });
+		}
+		first->E = graph.getE();
+		current = first;
+	}
+
+	ConcurrentGraph::Snapshot ConcurrentGraph::snapshot() const {
+		return std::atomic_load(&current);
+	}
+
+	bool ConcurrentGraph::addEdge(int x, int y, double w) {
+		bool added = false;
+		update([&](Version& g) { added = g.addEdge(x, y, w); });
+		return added;
+	}
+
+	bool ConcurrentGraph::removeEdge(int x, int y) {
+		bool removed = false;
+		update([&](Version& g) { removed = g.removeEdge(x, y); });
+		return removed;
+	}
+
+	void ConcurrentGraph::setEdgeValue(int x, int y, double v) {
+		update([&](Version& g) { g.setEdgeValue(x, y, v); });
+	}
+
+	void ConcurrentGraph::publish(const std::shared_ptr<Version>& next) {
+		std::atomic_store(&current, Snapshot(next));
+		currentVersion.fetch_add(1, std::memory_order_release);
+	}
+}
@@ -0,0 +1,262 @@
+#ifndef CONCURRENTGRAPH_H_
+#define CONCURRENTGRAPH_H_
+
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <vector>
+
+#include "Graph.h"
+
+namespace Algorithms
+{
+	/**
+	 * The {@code ConcurrentGraph} class lets many threads query a graph
+	 * while another thread keeps changing it.
+	 *
+	 * Readers never see a graph that is being modified: they take a
+	 * <code>snapshot()</code>, an immutable <code>Version</code> that stays
+	 * valid for as long as they hold it, and run <code>MST</code> or
+	 * neighbor queries on it without any locking. A writer derives a new
+	 * version from the current one, applies its changes to it and publishes
+	 * it with a single atomic pointer store. Old versions are reclaimed when
+	 * their last reader drops them, as in RCU with reference-counted grace
+	 * periods.
+	 *
+	 * Versions share every row they do not change. A row is a sorted array
+	 * of arcs held by a <code>shared_ptr</code>, and the rows are grouped in
+	 * blocks of ROW_BLOCK pointers, so a write copies the row it changes,
+	 * the block holding that row and the V / ROW_BLOCK block pointers:
+	 * O(degree + ROW_BLOCK + V / ROW_BLOCK) rather than the whole graph.
+	 * <code>update</code> applies a batch of changes as one version, and
+	 * rows or blocks already copied within the batch are changed in place.
+	 *
+	 * @programmer Richard Caaya
+	 */
+	class ConcurrentGraph
+	{
+	public:
+
+		/**
+		 * The number of rows per block of row pointers.
+		 */
+		static const int ROW_BLOCK = 256;
+
+		/**
+		 * One immutable version of the graph, as seen by readers. The edges
+		 * are stored as given, one arc from x to y per <code>addEdge(x, y)</code>,
+		 * like <code>Graph</code>.
+		 */
+		class Version
+		{
+		public:
+
+			/**
+			 * Returns the number of vertices.
+			 * @return the number of vertices
+			 */
+			inline int getV() const { return this->V; }
+
+			/**
+			 * Returns the number of edges.
+			 * @return the number of edges
+			 */
+			inline int getE() const { return this->E; }
+
+			/**
+			 * Tests whether there is an edge from node x to node y
+			 *
+			 * @param x the node x
+			 * @param y the node y
+			 * @return TRUE if there is an edge from node x to node y
+			 */
+			bool isAdjacent(int x, int y) const;
+
+			/**
+			 * Returns the weight of the edge x-y.
+			 *
+			 * @param x the node x
+			 * @param y the node y
+			 * @return the weight, or infinity if there is no such edge
+			 */
+			double getEdgeValue(int x, int y) const;
+
+			/**
+			 * Returns the degree of vertex
+			 * @param x the vertex
+			 * @return the number of edges from x
+			 */
+			int getDegree(int x) const;
+
+			/**
+			 * Calls visit(y, w) for every edge x-y of weight w, in increasing y.
+			 *
+			 * @param x the node to enumerate
+			 * @param visit a callable taking (int, double)
+			 */
+			template <typename Visitor>
+			void forEachNeighbor(int x, Visitor visit) const {
+				const Row* row = getRow(x);
+				if (row == NULL)
+					return;
+				for (const Arc& arc : row->arcs)
+					visit(arc.to, arc.weight);
+			}
+
+			/**
+			 * Copies this version into a standalone <code>Graph</code>, for
+			 * code that needs <code>Edge</code> objects.
+			 *
+			 * @param representation the storage of the new graph
+			 * @return a graph with the same edges
+			 */
+			Graph toGraph(Graph::Representation representation = Graph::AUTO) const;
+
+			/**
+			 * Adds the edge x-y. Only available inside <code>ConcurrentGraph::update</code>.
+			 * @see Graph::addEdge
+			 */
+			bool addEdge(int x, int y, double w = 0.0);
+
+			/**
+			 * Removes the edge x-y. Only available inside <code>ConcurrentGraph::update</code>.
+			 * @see Graph::removeEdge
+			 */
+			bool removeEdge(int x, int y);
+
+			/**
+			 * Sets the weight of the edge x-y, if there is one. Only
+			 * available inside <code>ConcurrentGraph::update</code>.
+			 *
+			 * @return TRUE if the weight changed
+			 * @see Graph::setEdgeValue
+			 */
+			bool setEdgeValue(int x, int y, double v);
+
+		private:
+			friend class ConcurrentGraph;
+
+			struct Arc {
+				int to;
+				double weight;
+			};
+
+			struct Row {
+				long stamp;					// the version that created this row
+				std::vector<Arc> arcs;		// sorted by to
+			};
+
+			struct Block {
+				long stamp;					// the version that created this block
+				std::shared_ptr<Row> rows[ROW_BLOCK];	// NULL for a row without edges
+			};
+
+			int V;
+			int E;
+			long stamp;					// rows and blocks with this stamp belong to this version alone
+			bool modified;				// a change was made since this version was derived
+			std::vector<std::shared_ptr<Block> > blocks;
+
+			Version(int V);
+
+			/**
+			 * Derives the draft of version stamp from other, sharing all of its rows.
+			 */
+			Version(const Version& other, long stamp);
+
+			inline const Row* getRow(int x) const {
+				return blocks[x / ROW_BLOCK]->rows[x % ROW_BLOCK].get();
+			}
+
+			/**
+			 * Returns row x for writing, copying it and its block first if
+			 * they are shared with an earlier version.
+			 */
+			Row& writableRow(int x);
+
+			/**
+			 * Returns the position of the first arc of row at or after y.
+			 */
+			static std::vector<Arc>::const_iterator find(const Row& row, int y);
+
+			Version(const Version&);
+			Version& operator=(const Version&);
+		};
+
+		typedef std::shared_ptr<const Version> Snapshot;
+
+		/**
+		 * Initializes an empty graph with V vertices and 0 edges.
+		 *
+		 * @param V the number of vertices
+		 */
+		ConcurrentGraph(int V = MAX_GRAPH_SIZE);
+
+		/**
+		 * Initializes a concurrent graph whose first version has the edges of graph.
+		 *
+		 * @param graph the graph to copy
+		 */
+		explicit ConcurrentGraph(const Graph& graph);
+
+		/**
+		 * Returns the current version of the graph. Never blocks on writers.
+		 *
+		 * @return an immutable snapshot of the graph
+		 */
+		Snapshot snapshot() const;
+
+		/**
+		 * Returns the number of versions published so far.
+		 *
+		 * @return the version number of the current snapshot
+		 */
+		long version() const { return this->currentVersion.load(std::memory_order_acquire); }
+
+		/**
+		 * Adds the edge x-y and publishes the new version, if it was not there.
+		 * @see Graph::addEdge
+		 */
+		bool addEdge(int x, int y, double w = 0.0);
+
+		/**
+		 * Removes the edge x-y and publishes the new version, if it was there.
+		 * @see Graph::removeEdge
+		 */
+		bool removeEdge(int x, int y);
+
+		/**
+		 * Sets the weight of the edge x-y and publishes the new version, if
+		 * the weight changed.
+		 * @see Graph::setEdgeValue
+		 */
+		void setEdgeValue(int x, int y, double v);
+
+		/**
+		 * Applies a batch of changes to a draft derived from the current
+		 * version, then publishes it as one new version if anything changed.
+		 *
+		 * @param mutate a callable taking a <code>ConcurrentGraph::Version&</code>
+		 */
+		template <typename Mutator>
+		void update(Mutator mutate) {
+			std::lock_guard<std::mutex> lock(writerMutex);
+			std::shared_ptr<Version> next(new Version(*snapshot(), version() + 1));
+			mutate(*next);
+			if (next->modified)
+				publish(next);
+		}
+
+	private:
+		Snapshot current;				// only accessed through std::atomic_load / std::atomic_store
+		std::atomic<long> currentVersion;
+		std::mutex writerMutex;			// serializes writers; readers never take it
+
+		void publish(const std::shared_ptr<Version>& next);
+
+		ConcurrentGraph(const ConcurrentGraph&);
+		ConcurrentGraph& operator=(const ConcurrentGraph&);
+	};
+}
+
+#endif /* CONCURRENTGRAPH_H_ */
@@ -40,6 +40,10 @@ namespace Algorithms
 			return weight;
 		}
 
+		inline void setWeight(double weight) {
+			this->weight = weight;
+		}
+
 		/**
 		 * Returns either end-point of this edge.
 		 *
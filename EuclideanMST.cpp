@@ -0,0 +1,410 @@
+/**
+ * EuclideanMST.cpp
+ *
+ *  Programmer: Richard Caaya
+ */
+
+#include "EuclideanMST.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "ThreadPool.h"
+
+namespace Algorithms
+{
+	static const int QUERY_BLOCK = 256;		// points a thread takes at a time
+
+	/**
+	 * Returns true if the edge p-q of squared length d comes before the
+	 * edge r-s of squared length e. Every thread uses the same order.
+	 */
+	static bool shorter(double d, int p, int q, double e, int r, int s) {
+		if (d != e)
+			return d < e;
+		if (std::min(p, q) != std::min(r, s))
+			return std::min(p, q) < std::min(r, s);
+		return std::max(p, q) < std::max(r, s);
+	}
+
+	static int findRoot(std::vector<int>& parent, int v) {
+		while (parent[v] != v) {
+			parent[v] = parent[parent[v]];
+			v = parent[v];
+		}
+		return v;
+	}
+
+	/**
+	 * A k-d tree over the points, stored in tree order so every node holds
+	 * a contiguous range of them. Each node also knows the component shared
+	 * by all its points, or -1 if they are in several.
+	 */
+	class KdTree {
+	public:
+		KdTree(const std::vector<double>& coordinates, int dimension) :
+				d(dimension), original((int) (coordinates.size() / dimension)), component(NULL) {
+			const int V = (int) original.size();
+			for (int i = 0; i < V; ++i)
+				original[i] = i;
+			leafOf.resize(V);
+			if (V > 0) {
+				std::vector<double> box(2 * d);
+				for (int k = 0; k < d; ++k) {
+					box[k] = std::numeric_limits<double>::infinity();
+					box[d + k] = -std::numeric_limits<double>::infinity();
+				}
+				for (int i = 0; i < V; ++i) {
+					for (int k = 0; k < d; ++k) {
+						box[k] = std::min(box[k], coordinates[(size_t) i * d + k]);
+						box[d + k] = std::max(box[d + k], coordinates[(size_t) i * d + k]);
+					}
+				}
+				Node root = { 0, V, -1, -1 };
+				nodes.push_back(root);
+				boxes.resize(2 * d);
+				std::vector<std::pair<double, int> > keys;
+				build(coordinates, 0, box, keys);
+			}
+
+			points.resize(coordinates.size());
+			for (int p = 0; p < V; ++p)
+				std::copy(&coordinates[0] + (size_t) original[p] * d, &coordinates[0] + (size_t) (original[p] + 1) * d,
+						&points[0] + (size_t) p * d);
+		}
+
+		/**
+		 * Returns the input index of the point at position p in tree order
+		 */
+		int originalIndex(int p) const { return original[p]; }
+
+		/**
+		 * Records component[p] for every point p, in tree order
+		 */
+		void setComponents(const std::vector<int>& component) {
+			this->component = &component;
+			// children come after their parent, so walk backwards
+			for (int n = (int) nodes.size() - 1; n >= 0; --n) {
+				Node& node = nodes[n];
+				if (node.children < 0) {
+					int c = component[node.begin];
+					for (int p = node.begin + 1; p < node.end && c >= 0; ++p)
+						if (component[p] != c)
+							c = -1;
+					node.component = c;
+				}
+				else {
+					int c = nodes[node.children].component;
+					node.component = (nodes[node.children + 1].component == c) ? c : -1;
+				}
+			}
+		}
+
+		/**
+		 * Returns the squared distance between the points at p and q
+		 */
+		double distance(int p, int q) const {
+			const double* x = &points[0] + (size_t) p * d;
+			const double* y = &points[0] + (size_t) q * d;
+			double sum = 0.0;
+			for (int k = 0; k < d; ++k)
+				sum += (x[k] - y[k]) * (x[k] - y[k]);
+			return sum;
+		}
+
+		/**
+		 * Finds the point nearest to p outside its component, skipping
+		 * anything farther than bound. Sets to = -1 if there is none.
+		 *
+		 * @param p the point, in tree order
+		 * @param bound the shortest edge found so far out of p's component, squared
+		 * @param best the squared distance to the point found
+		 * @param to the point found, in tree order; on entry, a point outside
+		 *        the component to start from, or -1
+		 */
+		void nearest(int p, const std::atomic<double>& bound, double& best, int& to) const {
+			Query query = { p, (*component)[p], &points[0] + (size_t) p * d, &bound,
+					std::numeric_limits<double>::infinity(), -1 };
+			if (to >= 0 && (*component)[to] != query.component) {
+				query.best = distance(p, to);
+				query.to = to;
+			}
+			// the point's own leaf usually holds a near neighbor, which makes the bound tight early
+			if (nodes[leafOf[p]].component != query.component)
+				scan(nodes[leafOf[p]], query);
+			if (nodes[0].component != query.component)
+				search(0, query);
+			best = query.best;
+			to = query.to;
+		}
+
+	private:
+		struct Node {
+			int begin;			// points [begin, end) in tree order
+			int end;
+			int children;		// the children are nodes children and children + 1; -1 for a leaf
+			int component;
+		};
+
+		struct Query {
+			int p;
+			int component;
+			const double* at;
+			const std::atomic<double>* bound;
+			double best;
+			int to;
+
+			double limit() const { return std::min(best, bound->load(std::memory_order_relaxed)); }
+
+			/**
+			 * Returns true if node may hold a point that beats the best one.
+			 * For a fixed p, equally near points are ordered by position.
+			 */
+			bool worthVisiting(double distance, const Node& node) const {
+				if (node.component == component)
+					return false;
+				double at = limit();
+				return distance < at || (distance == at && (distance < best || node.begin < to));
+			}
+		};
+
+		int d;
+		std::vector<int> original;			// original[p] = input index of the point at p
+		std::vector<double> points;			// coordinates in tree order
+		std::vector<Node> nodes;
+		std::vector<double> boxes;			// bounding box of node n: d lower bounds, then d upper bounds, at 2 * d * n
+		std::vector<int> leafOf;			// leafOf[p] = the leaf holding the point at p
+		const std::vector<int>* component;
+
+		/**
+		 * Splits node n, whose points lie in box (d lower bounds, then d
+		 * upper bounds), down to the leaves and sets its tight bounding box.
+		 * Siblings are allocated together so a search reads both boxes at once.
+		 */
+		void build(const std::vector<double>& coordinates, int n, std::vector<double>& box,
+				std::vector<std::pair<double, int> >& keys) {
+			const int begin = nodes[n].begin, end = nodes[n].end;
+			double* tight = &boxes[(size_t) 2 * d * n];
+
+			if (end - begin <= EUCLIDEAN_LEAF_SIZE) {
+				for (int k = 0; k < d; ++k) {
+					tight[k] = std::numeric_limits<double>::infinity();
+					tight[d + k] = -std::numeric_limits<double>::infinity();
+				}
+				for (int i = begin; i < end; ++i) {
+					const double* x = &coordinates[0] + (size_t) original[i] * d;
+					for (int k = 0; k < d; ++k) {
+						tight[k] = std::min(tight[k], x[k]);
+						tight[d + k] = std::max(tight[d + k], x[k]);
+					}
+					leafOf[i] = n;
+				}
+				return;
+			}
+
+			// split the widest side of box at the median
+			int axis = 0;
+			for (int k = 1; k < d; ++k)
+				if (box[d + k] - box[k] > box[d + axis] - box[axis])
+					axis = k;
+			keys.resize(end - begin);
+			for (int i = begin; i < end; ++i)
+				keys[i - begin] = std::make_pair(coordinates[(size_t) original[i] * d + axis], original[i]);
+			int middle = begin + (end - begin) / 2;
+			std::nth_element(keys.begin(), keys.begin() + (middle - begin), keys.end());
+			for (int i = begin; i < end; ++i)
+				original[i] = keys[i - begin].second;
+			double split = keys[middle - begin].first;
+
+			int children = (int) nodes.size();
+			Node left = { begin, middle, -1, -1 }, right = { middle, end, -1, -1 };
+			nodes.push_back(left);
+			nodes.push_back(right);
+			nodes[n].children = children;
+			boxes.resize(boxes.size() + 4 * d);
+
+			double saved = box[d + axis];
+			box[d + axis] = split;
+			build(coordinates, children, box, keys);
+			box[d + axis] = saved;
+			saved = box[axis];
+			box[axis] = split;
+			build(coordinates, children + 1, box, keys);
+			box[axis] = saved;
+
+			// the children's boxes are tight, so their union is too
+			tight = &boxes[(size_t) 2 * d * n];
+			const double* a = &boxes[(size_t) 2 * d * children];
+			const double* b = a + 2 * d;
+			for (int k = 0; k < d; ++k) {
+				tight[k] = std::min(a[k], b[k]);
+				tight[d + k] = std::max(a[d + k], b[d + k]);
+			}
+		}
+
+		double boxDistance(int n, const double* x) const {
+			const double* box = &boxes[(size_t) 2 * d * n];
+			double sum = 0.0;
+			for (int k = 0; k < d; ++k) {
+				double gap = std::max(0.0, std::max(box[k] - x[k], x[k] - box[d + k]));
+				sum += gap * gap;
+			}
+			return sum;
+		}
+
+		void scan(const Node& leaf, Query& query) const {
+			for (int q = leaf.begin; q < leaf.end; ++q) {
+				if ((*component)[q] == query.component)
+					continue;
+				const double* y = &points[0] + (size_t) q * d;
+				double sum = 0.0;
+				for (int k = 0; k < d; ++k)
+					sum += (query.at[k] - y[k]) * (query.at[k] - y[k]);
+				if (sum <= query.limit() && (sum < query.best || (sum == query.best && q < query.to))) {
+					query.best = sum;
+					query.to = q;
+				}
+			}
+		}
+
+		void search(int n, Query& query) const {
+			const Node& node = nodes[n];
+			if (node.children < 0) {
+				scan(node, query);
+				return;
+			}
+
+			// nearer child first; ties are kept so the end-point order can decide
+			int first = node.children, second = node.children + 1;
+			double toFirst = boxDistance(first, query.at), toSecond = boxDistance(second, query.at);
+			if (toSecond < toFirst) {
+				std::swap(first, second);
+				std::swap(toFirst, toSecond);
+			}
+			if (query.worthVisiting(toFirst, nodes[first]))
+				search(first, query);
+			if (query.worthVisiting(toSecond, nodes[second]))
+				search(second, query);
+		}
+	};
+
+	EuclideanMST::EuclideanMST(const std::vector<double>& coordinates, int dimension, unsigned int threads) : V(0) {
+		if (dimension <= 0 || coordinates.size() % dimension != 0)
+			throw std::invalid_argument("The coordinates do not divide into points of the given dimension");
+		this->V = (int) (coordinates.size() / dimension);
+		const int V = this->V;
+		if (V < 2)
+			return;
+
+		// identical points are joined first by zero-length edges, and only
+		// one point of each group goes into the k-d tree
+		std::vector<int> order(V);
+		for (int i = 0; i < V; ++i)
+			order[i] = i;
+		auto before = [&](int a, int b) {
+			return std::lexicographical_compare(&coordinates[0] + (size_t) a * dimension, &coordinates[0] + (size_t) (a + 1) * dimension,
+					&coordinates[0] + (size_t) b * dimension, &coordinates[0] + (size_t) (b + 1) * dimension);
+		};
+		std::sort(order.begin(), order.end(), before);
+
+		std::vector<double> distinct;
+		std::vector<int> representative;			// representative[u] = input index of distinct point u
+		tree.reserve(V - 1);
+		for (int i = 0; i < V; ++i) {
+			if (i > 0 && !before(order[i - 1], order[i])) {
+				tree.push_back(new Edge<int>(new Node<int>(representative.back()), new Node<int>(order[i]), 0.0));
+				continue;
+			}
+			representative.push_back(order[i]);
+			distinct.insert(distinct.end(), &coordinates[0] + (size_t) order[i] * dimension,
+					&coordinates[0] + (size_t) (order[i] + 1) * dimension);
+		}
+		std::vector<int>().swap(order);
+		const int U = (int) representative.size();
+
+		KdTree points(distinct, dimension);
+		std::vector<double>().swap(distinct);
+
+		std::vector<int> sets(U), component(U);
+		for (int p = 0; p < U; ++p)
+			sets[p] = p;
+		std::vector<double> best(U);				// best[p] = squared length of p's shortest edge out of its component
+		std::vector<int> to(U, -1);					// to[p] = the other end of that edge
+		std::vector<double> lower(U, 0.0);			// lower[p] <= best[p] in this and every later round
+		std::vector<std::atomic<double> > bound(U);	// bound[c] = shortest such edge of component c so far
+		std::vector<int> chosen(U, -1);				// chosen[c] = the point whose edge component c takes
+
+		int components = U;
+		while (components > 1) {
+			for (int p = 0; p < U; ++p) {
+				component[p] = findRoot(sets, p);
+				bound[p].store(std::numeric_limits<double>::infinity(), std::memory_order_relaxed);
+			}
+			points.setComponents(component);
+
+			auto lookup = [&](size_t first, size_t last) {
+				for (int p = (int) first; p < (int) last; ++p) {
+					std::atomic<double>& shortest = bound[component[p]];
+					if (lower[p] > shortest.load(std::memory_order_relaxed)) {
+						to[p] = -1;			// cannot beat the component's edge
+						continue;
+					}
+					points.nearest(p, shortest, best[p], to[p]);
+					double current = shortest.load(std::memory_order_relaxed);
+					// everything the search skipped was at least this far
+					lower[p] = std::min(best[p], current);
+					while (to[p] >= 0 && best[p] < current
+							&& !shortest.compare_exchange_weak(current, best[p], std::memory_order_relaxed)) {}
+				}
+			};
+			ThreadPool::shared().parallelFor(0, U, QUERY_BLOCK, lookup, threads);
+
+			// each component takes its shortest edge out
+			std::vector<int> roots;
+			for (int p = 0; p < U; ++p) {
+				if (to[p] < 0)
+					continue;
+				int c = component[p], q = chosen[c];
+				if (q < 0)
+					roots.push_back(c);
+				if (q < 0 || shorter(best[p], p, to[p], best[q], q, to[q]))
+					chosen[c] = p;
+			}
+
+			int merged = 0;
+			for (int c : roots) {
+				int p = chosen[c], q = to[p];
+				chosen[c] = -1;
+				int rp = findRoot(sets, p), rq = findRoot(sets, q);
+				if (rp == rq)
+					continue;					// the other component chose the same edge
+				sets[rp] = rq;
+				components--;
+				merged++;
+				tree.push_back(new Edge<int>(new Node<int>(representative[points.originalIndex(p)]),
+						new Node<int>(representative[points.originalIndex(q)]), std::sqrt(best[p])));
+			}
+			if (merged == 0)
+				break;
+		}
+	}
+
+	EuclideanMST::~EuclideanMST() {
+		for (Edge<int>* e : tree)
+			delete e;
+	}
+
+	const std::vector<Edge<int>*> EuclideanMST::edges() const {
+		return tree;
+	}
+
+	double EuclideanMST::cost() const {
+		double weight = 0.0;
+		for (Edge<int>* e : tree)
+			weight += e->getWeight();
+		return weight;
+	}
+}
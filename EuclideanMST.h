@@ -0,0 +1,83 @@
+#ifndef EUCLIDEANMST_H_
+#define EUCLIDEANMST_H_
+
+#include <vector>
+
+#include "Edge.h"
+
+namespace Algorithms
+{
+	/**
+	 * Points per leaf of the k-d tree of an <code>EuclideanMST</code>.
+	 */
+	const int EUCLIDEAN_LEAF_SIZE = 8;
+
+	/**
+	 * The {@code EuclideanMST} class computes a minimum spanning tree of a
+	 * set of points under the Euclidean distance, without building the
+	 * complete graph of V(V-1)/2 edges.
+	 *
+	 * The points go into a k-d tree, and the tree is grown by Boruvka's
+	 * algorithm: every round, each point looks up its nearest point in
+	 * another component, each component keeps the shortest of those edges,
+	 * and all of them are added at once. The tree search skips any subtree
+	 * that lies entirely inside the point's own component, and any subtree
+	 * farther away than the best edge found so far for that component.
+	 * Components at least halve every round, so there are at most log2(V)
+	 * rounds, and the lookups of a round run on several threads.
+	 *
+	 * Identical points are joined first by zero-length edges and enter the
+	 * tree once. Ties are broken by end-points, so the tree is always
+	 * acyclic. Memory is O(V) for a fixed dimension.
+	 *
+	 * @programmer Richard Caaya
+	 */
+	class EuclideanMST
+	{
+	public:
+
+		/**
+		 * Compute a Euclidean minimum spanning tree of a set of points.
+		 *
+		 * @param coordinates the points, dimension values per point: point i
+		 *        is coordinates[i * dimension] .. coordinates[i * dimension + dimension - 1]
+		 * @param dimension the number of coordinates per point
+		 * @param threads the most threads for the lookups (0 = all of <code>ThreadPool::shared()</code>)
+		 * @throws <code>std::invalid_argument</code> if dimension is not
+		 *         positive or does not divide the number of coordinates
+		 */
+		EuclideanMST(const std::vector<double>& coordinates, int dimension, unsigned int threads = 0);
+
+		/**
+		 * Destructor
+		 */
+		~EuclideanMST();
+
+		/**
+		 * Returns the number of points.
+		 * @return the number of points
+		 */
+		inline int getV() const { return this->V; }
+
+		/**
+		 * Returns the edges in a minimum spanning tree, weighted by length
+		 * @return the edges in a minimum spanning tree as a vector of edges
+		 */
+		const std::vector<Edge<int>*> edges() const;
+
+		/**
+		 * Returns the sum of the edge lengths in a minimum spanning tree.
+		 * @return the total cost
+		 */
+		double cost() const;
+
+	private:
+		int V;
+		std::vector<Edge<int>*> tree;
+
+		EuclideanMST(const EuclideanMST&);
+		EuclideanMST& operator=(const EuclideanMST&);
+	};
+}
+
+#endif /* EUCLIDEANMST_H_ */
@@ -7,6 +7,7 @@
  */
 
 #include "Graph.h"
+#include "ThreadPool.h"
 
 #include <cassert>
 #include <fstream>
@@ -15,18 +16,33 @@
 #include <iterator>
 #include <iomanip>
 #include <iterator>
+#include <stdexcept>
+#include <limits>
 
 namespace Algorithms
 {
-	Graph::Graph(int V) :
+	Graph::Graph(int V, Representation representation) :
 			V(V),
 			E(0),
-			adjacencyList(std::vector<listOfEdges>(V)) {
+			requested(representation),
+			matrix(false),
+			rowWords(0),
+			adjacencyList(std::vector<listOfEdges>(V)),
+			edgesValid(true) {
 
 		assert(V >= 0); // Number of vertices must be positive
+
+		if (representation == ADJACENCY_MATRIX)
+			setRepresentation(ADJACENCY_MATRIX);
 	}
 
-    Graph::Graph(const std::string& filename) {
+    Graph::Graph(const std::string& filename, Representation representation) :
+    		V(0),
+    		E(0),
+    		requested(representation),
+    		matrix(false),
+    		rowWords(0),
+    		edgesValid(true) {
 
         std::ifstream inFile(filename.c_str());
         std::istream_iterator<std::string> start(inFile), end;
@@ -43,15 +59,24 @@ namespace Algorithms
         this->E = 0;
         this->adjacencyList = std::vector<listOfEdges>(V);
 
+        if (representation == ADJACENCY_MATRIX)
+        	setRepresentation(ADJACENCY_MATRIX);
+
         for (unsigned int i = 1; i < uvw.size()-2; i+=3) {
         	int u = convert<int>(uvw[i]);
         	int v = convert<int>(uvw[i+1]);
         	double w = convert<double>(uvw[i+2]);
         	this->addEdge(u, v, w);
         }
+
+        autoRepresentation();
     }
 
 	Graph::~Graph() {
+		releaseEdges();
+	}
+
+	void Graph::releaseEdges() const {
 
 		for (unsigned int i = 0; i < adjacencyList.size(); ++i) {
 			listOfEdgesItr itr = adjacencyList[i].begin();
@@ -59,34 +84,109 @@ namespace Algorithms
 				delete *itr;
 				++itr;
 			}
+			adjacencyList[i].clear();
 		}
 	}
 
-	Graph* Graph::clone() const {
-		Graph* g = new Graph();
-		g->V = this->V;
-		g->E = this->E;
+	void Graph::materializeEdges() const {
+		if (edgesValid.load(std::memory_order_acquire))
+			return;
+
+		std::lock_guard<std::mutex> lock(edgesMutex);
+		if (edgesValid.load(std::memory_order_relaxed))
+			return;
+
+		releaseEdges();
+		for (int x = 0; x < V; ++x) {
+			forEachNeighbor(x, [this, x](int y, double w) {
+				adjacencyList[x].push_back(new Edge<int>(new Node<int>(x), new Node<int>(y), w));
+			});
+		}
+		edgesValid.store(true, std::memory_order_release);
+	}
 
-		for (unsigned int i = 0; i < this->adjacencyList.size(); ++i) {
-			std::copy(this->adjacencyList[i].begin(), this->adjacencyList[i].end(),
-					g->adjacencyList[i].begin());
+	void Graph::invalidateEdges() {
+		if (matrix && edgesValid.load(std::memory_order_relaxed)) {
+			releaseEdges();
+			edgesValid.store(false, std::memory_order_relaxed);
 		}
-		return g;
 	}
 
-	Graph::Graph(const Graph& other) {
-		if(this != &other) {
-			*this = other;
+	void Graph::autoRepresentation() {
+		if (requested == AUTO)
+			setRepresentation(AUTO);
+	}
+
+	void Graph::setRepresentation(Representation representation) {
+		if (representation == AUTO) {
+			double maxEdges = (double) V * (V - 1) / 2;
+			representation = (V > 1 && E >= DENSE_REPRESENTATION_DENSITY * maxEdges) ? ADJACENCY_MATRIX : ADJACENCY_LISTS;
+		}
+
+		if (representation == getRepresentation())
+			return;
+
+		if (representation == ADJACENCY_MATRIX) {
+			rowWords = (V + 63) / 64;
+			adjacencyMatrix.assign((size_t) V * rowWords, 0);
+			weightMatrix.assign((size_t) V * V, std::numeric_limits<double>::infinity());
+
+			for (int x = 0; x < V; ++x) {
+				for (const Edge<int>* e : adjacencyList[x]) {
+					int y = e->getY()->getValue();
+					adjacencyMatrix[(size_t) x * rowWords + y / 64] |= uint64_t(1) << (y % 64);
+					weightMatrix[(size_t) x * V + y] = e->getWeight();
+				}
+			}
+
+			releaseEdges();
+			matrix = true;
+			edgesValid.store(false, std::memory_order_relaxed);
 		}
+		else {
+			materializeEdges();
+			matrix = false;
+			rowWords = 0;
+			std::vector<uint64_t>().swap(adjacencyMatrix);
+			std::vector<double>().swap(weightMatrix);
+		}
+	}
+
+	Graph* Graph::clone() const {
+		return new Graph(*this);
+	}
+
+	Graph::Graph(const Graph& other) :
+			V(0),
+			E(0),
+			requested(other.requested),
+			matrix(false),
+			rowWords(0),
+			edgesValid(true) {
+		*this = other;
 	}
 
 	Graph& Graph::operator=(const Graph& other) {
 		if (this != &other) {
+			releaseEdges();
+
 			this->V = other.V;
 			this->E = other.E;
-
-			for (unsigned int i = 0; i < other.adjacencyList.size(); ++i) {
-				std::copy(other.adjacencyList[i].begin(), other.adjacencyList[i].end(), this->adjacencyList[i].begin());
+			this->requested = other.requested;
+			this->matrix = other.matrix;
+			this->rowWords = other.rowWords;
+			this->adjacencyMatrix = other.adjacencyMatrix;
+			this->weightMatrix = other.weightMatrix;
+			this->adjacencyList = std::vector<listOfEdges>(other.V);
+			this->edgesValid.store(!other.matrix, std::memory_order_relaxed);
+
+			if (!other.matrix) {
+				for (int i = 0; i < other.V; ++i) {
+					for (const Edge<int>* e : other.adjacencyList[i]) {
+						this->adjacencyList[i].push_back(new Edge<int>(new Node<int>(e->getX()->getValue()),
+								new Node<int>(e->getY()->getValue()), e->getWeight()));
+					}
+				}
 			}
 		}
 		return *this;
@@ -96,22 +196,26 @@ namespace Algorithms
 
 		// optimization: if sizes not same, graphs not equal
 		if (this->getV() != other.getV()
-				|| this->getE() != other.getE()
-				|| this->adjacencyList.size() != other.adjacencyList.size()) {
+				|| this->getE() != other.getE()) {
 			return false;
 		}
 
-		for (unsigned int i = 0; i < this->adjacencyList.size(); ++i) {
-
-			listOfEdgesConstItr thisItr = this->adjacencyList[i].begin();
-			listOfEdgesConstItr otherItr = other.adjacencyList[i].begin();
+		if (this->matrix && other.matrix) {
+			return this->adjacencyMatrix == other.adjacencyMatrix
+					&& this->weightMatrix == other.weightMatrix;
+		}
 
-			while (thisItr != adjacencyList[i].end()) {
-				if( (*thisItr) != (*otherItr)) {
-					return false;
-				}
-				++thisItr;
-				++otherItr;
+		// compare the rows as sorted (neighbor, weight) sequences
+		std::vector<std::pair<int, double> > thisRow, otherRow;
+		for (int x = 0; x < V; ++x) {
+			thisRow.clear();
+			otherRow.clear();
+			this->forEachNeighbor(x, [&thisRow](int y, double w) { thisRow.push_back(std::make_pair(y, w)); });
+			other.forEachNeighbor(x, [&otherRow](int y, double w) { otherRow.push_back(std::make_pair(y, w)); });
+			std::sort(thisRow.begin(), thisRow.end());
+			std::sort(otherRow.begin(), otherRow.end());
+			if (thisRow != otherRow) {
+				return false;
 			}
 		}
 		return true;
@@ -125,6 +229,10 @@ namespace Algorithms
 		assert(x > 0 || x <= V);
 		assert(y > 0 || y <= V);
 
+		if (matrix) {
+			return (adjacencyMatrix[(size_t) x * rowWords + y / 64] >> (y % 64)) & 1;
+		}
+
 		listOfEdgesConstItr itr = adjacencyList[x].begin();
 
 		while (itr != adjacencyList[x].end()) {
@@ -138,6 +246,7 @@ namespace Algorithms
 
 	const Graph::listOfEdges Graph::getNeighbors(int x) const {
 		assert(x > 0 || x <= V);
+		materializeEdges();
 		return adjacencyList[x];
 	}
 
@@ -145,9 +254,23 @@ namespace Algorithms
 		assert(x > 0 || x <= V);
 		assert(y > 0 || y <= V);
 
+		if (matrix) {
+			uint64_t& word = adjacencyMatrix[(size_t) x * rowWords + y / 64];
+			uint64_t bit = uint64_t(1) << (y % 64);
+			if (word & bit) {
+				return false;
+			}
+			word |= bit;
+			weightMatrix[(size_t) x * V + y] = w;
+			E++;
+			if (edgesValid.load(std::memory_order_relaxed))
+				adjacencyList[x].push_back(new Edge<int>(new Node<int>(x), new Node<int>(y), w));
+			return true;
+		}
+
 		listOfEdgesItr itr = adjacencyList[x].begin();
 		while (itr != adjacencyList[x].end()) {
-			if( (*itr)->getX()->getValue() == y) {
+			if( (*itr)->getY()->getValue() == y) {
 				return false;
 			}
 			++itr;
@@ -162,12 +285,36 @@ namespace Algorithms
 		assert(x > 0 || x <= V);
 		assert(y > 0 || y <= V);
 
+		if (matrix) {
+			uint64_t& word = adjacencyMatrix[(size_t) x * rowWords + y / 64];
+			uint64_t bit = uint64_t(1) << (y % 64);
+			if (!(word & bit)) {
+				return false;
+			}
+			word &= ~bit;
+			weightMatrix[(size_t) x * V + y] = std::numeric_limits<double>::infinity();
+			E--;
+
+			// drop the Edge as well, as a list graph does
+			if (edgesValid.load(std::memory_order_relaxed)) {
+				for (listOfEdgesItr itr = adjacencyList[x].begin(); itr != adjacencyList[x].end(); ++itr) {
+					if ((*itr)->getY()->getValue() == y) {
+						delete *itr;
+						adjacencyList[x].erase(itr);
+						break;
+					}
+				}
+			}
+			return true;
+		}
+
 		listOfEdgesItr itr = adjacencyList[x].begin();
 		while (itr != adjacencyList[x].end()) {
-			if ((*itr)->getX()->getValue() == y) {
-				adjacencyList[x].remove(*itr);
+			if ((*itr)->getY()->getValue() == y) {
+				Edge<int>* e = *itr;
+				adjacencyList[x].erase(itr);
 				E--;
-				delete *itr;
+				delete e;
 				return true;
 			}
 			++itr;
@@ -177,6 +324,7 @@ namespace Algorithms
 
 	const Node<int>* Graph::getNodeValue(int x) const {
 		assert(x > 0 || x <= V);
+		materializeEdges();
 
 		listOfEdgesConstItr itr = adjacencyList[x].begin();
 		while (itr != adjacencyList[x].end()) {
@@ -192,6 +340,9 @@ namespace Algorithms
 		assert(x > 0 || x <= V);
 		assert(a > 0 || a <= V);
 
+		// the nodes live in the Edge objects, which the matrix does not keep
+		setRepresentation(ADJACENCY_LISTS);
+
 		listOfEdgesConstItr itr = adjacencyList[x].begin();
 		while (itr != adjacencyList[x].end()) {
 			if ((*itr)->getX()->getValue() == x) {
@@ -201,9 +352,30 @@ namespace Algorithms
 		}
 	}
 
+	void Graph::setEdgeValue(int x, int y, double v) {
+		assert(x > 0 || x <= V);
+		assert(y > 0 || y <= V);
+
+		if (matrix) {
+			if (!isAdjacent(x, y))
+				return;
+			weightMatrix[(size_t) x * V + y] = v;
+			if (!edgesValid.load(std::memory_order_relaxed))
+				return;
+			// otherwise update the Edge in place, so pointers to it stay valid
+		}
+
+		for (Edge<int>* e : adjacencyList[x]) {
+			if (e->getY()->getValue() == y) {
+				e->setWeight(v);
+			}
+		}
+	}
+
 	const Edge<int>* Graph::getEdgeValue(int x, int y) const {
 		assert(x > 0 || x <= V);
 		assert(y > 0 || y <= V);
+		materializeEdges();
 
 		listOfEdgesConstItr itr = adjacencyList[x].begin();
 		while (itr != adjacencyList[x].end()) {
@@ -217,29 +389,90 @@ namespace Algorithms
 
 	int Graph::getDegree(int v) const {
 		assert(v > 0 || v <= V);
+
+		if (matrix) {
+			int degree = 0;
+			const uint64_t* row = &adjacencyMatrix[(size_t) v * rowWords];
+			for (int i = 0; i < rowWords; ++i)
+				degree += __builtin_popcountll(row[i]);
+			return degree;
+		}
 		return adjacencyList[v].size();
 	}
 
-	std::ostream& operator<<(std::ostream &os, const Graph& graph) {
-		std::stringstream ss;
+	static const size_t RELABEL_GRAIN = 1024;		// rows a thread takes at a time
 
-		ss << "Graph (" << graph.getV() << "," << graph.getE() << ")" << std::endl;
-		ss << "The Adjacency List K(" << graph.getV() << ")" << std::endl;
+	static bool lessByNeighbor(const Edge<int>* a, const Edge<int>* b) {
+		return a->getY()->getValue() < b->getY()->getValue();
+	}
 
-		for (unsigned int i = 0; i < graph.adjacencyList.size(); ++i) {
-			ss << "Adjacency List[" << i << "] ";
+	void Graph::relabel(const std::vector<int>& permutation, unsigned int threads) {
+		if (permutation.size() != adjacencyList.size())
+			throw std::invalid_argument("Permutation size does not match the number of vertices");
 
-			Graph::listOfEdgesConstItr itr = graph.adjacencyList[i].begin();
+		std::vector<bool> seen(permutation.size());
+		for (unsigned int v = 0; v < permutation.size(); ++v) {
+			int p = permutation[v];
+			if (p < 0 || p >= (int) permutation.size() || seen[p])
+				throw std::invalid_argument("Not a permutation of the vertices");
+			seen[p] = true;
+		}
 
-			while (itr!= graph.adjacencyList[i].end()) {
-				ss << std::setprecision(2);
-				ss << " -> " << (*itr)->getY()->getValue() << "(" << (*itr)->getWeight() << ")";
-				++itr;
+		// every old row maps to exactly one new row, so the workers write disjoint rows
+		std::vector<listOfEdges> relabelled(matrix ? 0 : adjacencyList.size());
+		std::vector<uint64_t> relabelledBits(matrix ? adjacencyMatrix.size() : 0, 0);
+		std::vector<double> relabelledWeights(matrix ? weightMatrix.size() : 0, std::numeric_limits<double>::infinity());
+
+		auto worker = [&](size_t begin, size_t end) {
+			for (size_t x = begin; x < end; ++x) {
+				int nx = permutation[x];
+				if (matrix) {
+					forEachNeighbor(x, [&](int y, double w) {
+						int ny = permutation[y];
+						relabelledBits[(size_t) nx * rowWords + ny / 64] |= uint64_t(1) << (ny % 64);
+						relabelledWeights[(size_t) nx * V + ny] = w;
+					});
+					continue;
+				}
+				for (Edge<int>* e : adjacencyList[x]) {
+					int ny = permutation[e->getY()->getValue()];
+					relabelled[nx].push_back(new Edge<int>(new Node<int>(nx), new Node<int>(ny), e->getWeight()));
+					delete e;
+				}
+				relabelled[nx].sort(lessByNeighbor);
 			}
-			ss << std::endl;
+		};
+
+		ThreadPool::shared().parallelFor(0, adjacencyList.size(), RELABEL_GRAIN, worker, threads);
+
+		if (matrix) {
+			invalidateEdges();
+			adjacencyMatrix.swap(relabelledBits);
+			weightMatrix.swap(relabelledWeights);
+		}
+		else {
+			adjacencyList.swap(relabelled);
 		}
+	}
+
+	std::ostream& operator<<(std::ostream &os, const Graph& graph) {
+		// written straight to the stream; GraphWriter exports at full precision
+		std::streamsize precision = os.precision(2);
+
+		os << "Graph (" << graph.getV() << "," << graph.getE() << ")" << std::endl;
+		os << "The Adjacency List K(" << graph.getV() << ")" << std::endl;
+
+		for (int i = 0; i < graph.getV(); ++i) {
+			os << "Adjacency List[" << i << "] ";
 
-		return (os << ss.str());
+			graph.forEachNeighbor(i, [&os](int y, double w) {
+				os << " -> " << y << "(" << w << ")";
+			});
+			os << std::endl;
+		}
+
+		os.precision(precision);
+		return os;
 	}
 
 	void Graph::generateRandomGraph(double density, double minDistance, double maxDistance) {
@@ -251,6 +484,10 @@ namespace Algorithms
 		std::cout << "MAX_NUM_EDGES: " << MAX_NUM_EDGES << std::endl;
 		std::cout << "EDGE_LIMIT: " << EDGE_LIMIT << std::endl;
 
+		// a dense target is cheaper to build with O(1) adjacency tests
+		if (requested == AUTO && density >= DENSE_REPRESENTATION_DENSITY)
+			setRepresentation(ADJACENCY_MATRIX);
+
 		srand(time(NULL));
 
 		while (this->getE() < EDGE_LIMIT) {
@@ -268,5 +505,7 @@ namespace Algorithms
 			double w = minDistance + f * (maxDistance - minDistance);
 			this->addEdge(x, y, w);
 		}
+
+		autoRepresentation();
 	}
 }
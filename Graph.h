@@ -8,6 +8,9 @@
 #include <sstream>
 #include <utility>
 #include <string>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
 
 #include "Node.h"
 #include "Edge.h"
@@ -16,6 +19,13 @@ namespace Algorithms
 {
 	const int MAX_GRAPH_SIZE = 50;
 
+	/**
+	 * An AUTO graph switches to the adjacency-matrix representation after a
+	 * bulk load once it has at least this fraction of the V(V-1)/2 possible
+	 * edges, which is roughly where the matrix becomes the smaller of the two.
+	 */
+	const double DENSE_REPRESENTATION_DENSITY = 0.25;
+
 	/**
 	 *	This class implements a parameterized <code>Graph</code> class used
 	 *	to represent <b><i>graphs,</i></b> which consist of a set of
@@ -34,7 +44,18 @@ namespace Algorithms
 	 *	   10) set_edge_value (G, x, y, v): sets the value associated to the edge (x,y) to v
 	 *
 	 *  This implementation uses an adjacency-lists representation, which 
-	 *  is a vectror of lists of <code>Edge</code> objects.
+	 *  is a vectror of lists of <code>Edge</code> objects, or for dense graphs
+	 *  an adjacency-matrix representation: a packed bitset of V x V bits plus
+	 *  a flat V x V weight matrix. In the matrix representation
+	 *  <code>isAdjacent</code> is a single bit test and neighbors are found
+	 *  by scanning 64-bit words. The operations that hand out
+	 *  <code>Edge</code> pointers still work on a matrix graph: they build
+	 *  the edge lists on first use, and from then on <code>addEdge</code>,
+	 *  <code>removeEdge</code> and <code>setEdgeValue</code> update both the
+	 *  matrix and the lists, so an <code>Edge</code> pointer stays valid
+	 *  exactly as long as it would on a list graph. The operations that
+	 *  write through the lists, <code>setNodeValue</code> and the non-const
+	 *  <code>getAdjacencyList</code>, convert the graph to lists first.
 	 *
 	 *  @programmer Richard Caaya
 	 */
@@ -46,20 +67,28 @@ namespace Algorithms
 		typedef listOfEdges::iterator listOfEdgesItr;				// the associated iterator of list of edges
 		typedef listOfEdges::const_iterator listOfEdgesConstItr;
 
+		enum Representation {
+			ADJACENCY_LISTS,	// vector of lists of Edge objects
+			ADJACENCY_MATRIX,	// bitset plus weight matrix
+			AUTO				// lists, switched to the matrix after a dense bulk load
+		};
+
 		/**
 		 * Initializes an empty graph with V vertices (50 by default) and 0 edges.
 		 * 
 		 * @param V the number of vertices
+		 * @param representation the storage to use
 		 */
-		Graph(int V = MAX_GRAPH_SIZE);
+		Graph(int V = MAX_GRAPH_SIZE, Representation representation = AUTO);
 
 
         /**
          * Initializes a graph with data read from file.
          *
          * @param filename The file name of the input data of integer triples: (i, j, cost).
+         * @param representation the storage to use
          */
-        Graph(const std::string& filename);
+        Graph(const std::string& filename, Representation representation = AUTO);
 
 		/**
 		 * Destructor
@@ -116,6 +145,61 @@ namespace Algorithms
 		 */
 		inline int getE() const { return this->E; }
 
+		/**
+		 * Returns the storage currently used by this graph
+		 * (never <code>AUTO</code>).
+		 *
+		 * @return the current representation
+		 */
+		inline Representation getRepresentation() const {
+			return this->matrix ? ADJACENCY_MATRIX : ADJACENCY_LISTS;
+		}
+
+		/**
+		 * Converts this graph to the given representation. <code>AUTO</code>
+		 * picks the matrix if the graph reaches DENSE_REPRESENTATION_DENSITY
+		 * and the lists otherwise.
+		 *
+		 * @param representation the storage to convert to
+		 */
+		void setRepresentation(Representation representation);
+
+		/**
+		 * Returns row x of the weight matrix: entry y is the weight of the
+		 * edge x-y, or infinity if there is none. Only valid in the
+		 * adjacency-matrix representation.
+		 *
+		 * @param x the node x
+		 * @return a pointer to V weights
+		 */
+		inline const double* getWeightRow(int x) const {
+			return &weightMatrix[(size_t) x * V];
+		}
+
+		/**
+		 * Calls visit(y, w) for every edge x-y of weight w, without allocating.
+		 *
+		 * @param x the node to enumerate
+		 * @param visit a callable taking (int, double)
+		 */
+		template <typename Visitor>
+		void forEachNeighbor(int x, Visitor visit) const {
+			if (matrix) {
+				const uint64_t* row = &adjacencyMatrix[(size_t) x * rowWords];
+				const double* weights = getWeightRow(x);
+				for (int i = 0; i < rowWords; ++i) {
+					for (uint64_t bits = row[i]; bits != 0; bits &= bits - 1) {
+						int y = i * 64 + __builtin_ctzll(bits);
+						visit(y, weights[y]);
+					}
+				}
+			}
+			else {
+				for (const Edge<int>* e : adjacencyList[x])
+					visit(e->getY()->getValue(), e->getWeight());
+			}
+		}
+
 		/**
 		 * Tests whether there is an edge from node x to node y
 		 *
@@ -161,7 +245,9 @@ namespace Algorithms
 		const Node<int>* getNodeValue(int x) const;
 
 		/**
-		 * Sets the value associated with the node x to a
+		 * Sets the value associated with the node x to a. A matrix graph is
+		 * converted to adjacency lists first, since the nodes are held by
+		 * the <code>Edge</code> objects.
 		 * @param x node to be set to a
 		 */
 		void setNodeValue(int x, int a);
@@ -202,10 +288,32 @@ namespace Algorithms
 		void generateRandomGraph(double density, double minDistance, double maxDistance);
 
 		/**
-		 * Returns a reference to the internal adjacency list
+		 * Returns a reference to the internal adjacency list. A matrix graph
+		 * is converted to adjacency lists first, so that changes made
+		 * through the reference are kept.
+		 *
 		 * @return a reference to the internal adjacency list
 		 */
-		std::vector< std::list<Edge<int>* > >& getAdjacencyList() { return this->adjacencyList; }
+		std::vector< std::list<Edge<int>* > >& getAdjacencyList() { setRepresentation(ADJACENCY_LISTS); return this->adjacencyList; }
+
+		/**
+		 * Returns a read-only reference to the internal adjacency list
+		 * @return a read-only reference to the internal adjacency list
+		 */
+		const std::vector< std::list<Edge<int>* > >& getAdjacencyList() const { materializeEdges(); return this->adjacencyList; }
+
+		/**
+		 * Renumbers the vertices of this graph in place: vertex v becomes
+		 * vertex permutation[v]. Each relabelled adjacency list is sorted by
+		 * neighbor id so that a scan of it touches per-vertex arrays in
+		 * ascending order.
+		 *
+		 * @param permutation a bijection on [0, V), permutation[old] = new
+		 * @param threads the most threads to use (0 = all of <code>ThreadPool::shared()</code>)
+		 * @throws <code>std::invalid_argument</code> if permutation is not a
+		 *         bijection on [0, V)
+		 */
+		void relabel(const std::vector<int>& permutation, unsigned int threads = 0);
 
 		/**
 		 *	Prints out the graph structure
@@ -215,7 +323,34 @@ namespace Algorithms
 	private:
 		int V;
 		int E;
-		std::vector< std::list<Edge<int>* > > adjacencyList;
+		Representation requested;						// the representation asked for at construction
+		bool matrix;									// true if the matrix is the primary storage
+		int rowWords;									// 64-bit words per bitset row
+		std::vector<uint64_t> adjacencyMatrix;			// bit y of row x set if there is an edge x-y
+		std::vector<double> weightMatrix;				// weightMatrix[x * V + y] = weight of x-y, infinity if none
+		mutable std::vector< std::list<Edge<int>* > > adjacencyList;	// the edges, or a view of the matrix
+		mutable std::atomic<bool> edgesValid;			// matrix graph: adjacencyList is up to date
+		mutable std::mutex edgesMutex;					// serializes building the view
+
+		/**
+		 * Deletes every <code>Edge</code> in the adjacency lists
+		 */
+		void releaseEdges() const;
+
+		/**
+		 * Builds the adjacency lists from the matrix if they are stale
+		 */
+		void materializeEdges() const;
+
+		/**
+		 * Drops the list view of a matrix graph after a change
+		 */
+		void invalidateEdges();
+
+		/**
+		 * Switches to the matrix if this is an AUTO graph dense enough for it
+		 */
+		void autoRepresentation();
 
 		/// Conversion from string to template type.
 		//  Types that you would like to convert to
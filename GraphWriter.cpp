@@ -0,0 +1,288 @@
+/**
+ * GraphWriter.cpp
+ *
+ *  Programmer: Richard Caaya
+ */
+
+#include "GraphWriter.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <utility>
+
+#if __cplusplus >= 201703L
+#include <charconv>
+#endif
+
+namespace Algorithms
+{
+	static void appendInt(std::string& out, long long value) {
+		char digits[24];
+		char* p = digits + sizeof(digits);
+		unsigned long long u = value < 0 ? 0ULL - value : value;
+		do {
+			*--p = '0' + (u % 10);
+			u /= 10;
+		} while (u != 0);
+		if (value < 0)
+			*--p = '-';
+		out.append(p, digits + sizeof(digits));
+	}
+
+	static void appendDouble(std::string& out, double value) {
+		char digits[32];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+		std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+		out.append(digits, result.ptr);
+#else
+		int n = snprintf(digits, sizeof(digits), "%.17g", value);
+		out.append(digits, n);
+#endif
+	}
+
+	/**
+	 * Rows read straight from a graph
+	 */
+	struct GraphRows {
+		const Graph& graph;
+
+		template <typename Visitor>
+		void operator()(int x, Visitor visit) const {
+			graph.forEachNeighbor(x, visit);
+		}
+	};
+
+	/**
+	 * Rows built from a list of edges, sorted by neighbor
+	 */
+	struct AdjacencyRows {
+		std::vector<size_t> offsets;
+		std::vector<std::pair<int, double> > targets;
+
+		/**
+		 * @param V the number of vertices
+		 * @param edges the (x, y, w) edges
+		 * @param symmetric if true, also add y-x for every x-y and drop loops and repeats
+		 */
+		AdjacencyRows(int V, const std::vector<std::pair<std::pair<int, int>, double> >& edges, bool symmetric) :
+			offsets(V + 1, 0) {
+
+			for (size_t i = 0; i < edges.size(); ++i) {
+				int x = edges[i].first.first, y = edges[i].first.second;
+				if (symmetric && x == y)
+					continue;
+				offsets[x + 1]++;
+				if (symmetric)
+					offsets[y + 1]++;
+			}
+			for (int v = 0; v < V; ++v)
+				offsets[v + 1] += offsets[v];
+
+			targets.resize(offsets[V]);
+			std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+			for (size_t i = 0; i < edges.size(); ++i) {
+				int x = edges[i].first.first, y = edges[i].first.second;
+				double w = edges[i].second;
+				if (symmetric && x == y)
+					continue;
+				targets[next[x]++] = std::make_pair(y, w);
+				if (symmetric)
+					targets[next[y]++] = std::make_pair(x, w);
+			}
+
+			// sort each row by neighbor; a symmetric row keeps one entry per neighbor
+			size_t kept = 0;
+			for (int v = 0; v < V; ++v) {
+				std::vector<std::pair<int, double> >::iterator begin = targets.begin() + offsets[v];
+				std::vector<std::pair<int, double> >::iterator end = targets.begin() + offsets[v + 1];
+				std::stable_sort(begin, end, lessByNeighbor);
+				if (symmetric)
+					end = std::unique(begin, end, sameNeighbor);
+				offsets[v] = kept;
+				for (; begin != end; ++begin)
+					targets[kept++] = *begin;
+			}
+			offsets[V] = kept;
+			targets.resize(kept);
+		}
+
+		template <typename Visitor>
+		void operator()(int x, Visitor visit) const {
+			for (size_t i = offsets[x]; i < offsets[x + 1]; ++i)
+				visit(targets[i].first, targets[i].second);
+		}
+
+		static bool lessByNeighbor(const std::pair<int, double>& a, const std::pair<int, double>& b) {
+			return a.first < b.first;
+		}
+
+		static bool sameNeighbor(const std::pair<int, double>& a, const std::pair<int, double>& b) {
+			return a.first == b.first;
+		}
+	};
+
+	GraphWriter::GraphWriter(std::ostream& os, Format format, unsigned int threads, size_t bufferSize, double weightScale) :
+		os(os),
+		format(format),
+		threads(std::max(1u, threads)),
+		bufferSize(std::max<size_t>(bufferSize, 64)),
+		weightScale(weightScale) {}
+
+	long long GraphWriter::integerWeight(double w) const {
+		return (long long) ((weightScale > 0) ? std::nearbyint(w * weightScale) : w);
+	}
+
+	template <typename Rows>
+	void GraphWriter::checkWeights(const Rows& rows, int V) const {
+		if (format != DIMACS && format != METIS)
+			return;
+
+		const double LIMIT = 9.2e18;	// within long long
+		for (int x = 0; x < V; ++x) {
+			rows(x, [this, LIMIT](int, double w) {
+				double scaled = (weightScale > 0) ? std::nearbyint(w * weightScale) : w;
+				if (!(std::fabs(scaled) < LIMIT) || scaled != std::floor(scaled))
+					throw std::invalid_argument("DIMACS and METIS need integer weights; set a weight scale to round them");
+			});
+		}
+	}
+
+	void GraphWriter::write(const Graph& graph) {
+		if (format != METIS) {
+			GraphRows rows = { graph };
+			writeRows(rows, graph.getV(), graph.getE());
+			return;
+		}
+
+		std::vector<std::pair<std::pair<int, int>, double> > edges;
+		edges.reserve(graph.getE());
+		for (int x = 0; x < graph.getV(); ++x) {
+			graph.forEachNeighbor(x, [&edges, x](int y, double w) {
+				edges.push_back(std::make_pair(std::make_pair(x, y), w));
+			});
+		}
+
+		AdjacencyRows rows(graph.getV(), edges, true);
+		writeRows(rows, graph.getV(), rows.targets.size() / 2);
+	}
+
+	void GraphWriter::write(const MST& mst) {
+		const int V = mst.getV();
+		const std::vector<Edge<int>*> tree = mst.edges();
+
+		std::vector<std::pair<std::pair<int, int>, double> > edges;
+		edges.reserve(tree.size());
+		for (const Edge<int>* e : tree)
+			edges.push_back(std::make_pair(std::make_pair(e->getX()->getValue(), e->getY()->getValue()), e->getWeight()));
+
+		AdjacencyRows rows(V, edges, format == METIS);
+		writeRows(rows, V, format == METIS ? rows.targets.size() / 2 : rows.targets.size());
+	}
+
+	void GraphWriter::writeHeader(int V, size_t E) {
+		std::string header;
+		switch (format) {
+		case EDGE_LIST:
+			appendInt(header, V);
+			break;
+		case DIMACS:
+			header += "p sp ";
+			appendInt(header, V);
+			header += ' ';
+			appendInt(header, E);
+			break;
+		case METIS:
+			appendInt(header, V);
+			header += ' ';
+			appendInt(header, E);
+			header += " 001";
+			break;
+		case MATRIX_MARKET:
+			header += "%%MatrixMarket matrix coordinate real general\n";
+			appendInt(header, V);
+			header += ' ';
+			appendInt(header, V);
+			header += ' ';
+			appendInt(header, E);
+			break;
+		}
+		header += '\n';
+		os.write(header.data(), header.size());
+	}
+
+	template <typename Rows>
+	void GraphWriter::formatRows(const Rows& rows, int begin, int end, std::string& out) const {
+		const int base = (format == EDGE_LIST) ? 0 : 1;
+
+		for (int x = begin; x < end; ++x) {
+			if (format == METIS) {
+				size_t lineStart = out.size();
+				rows(x, [&out, this](int y, double w) {
+					appendInt(out, y + 1);
+					out += ' ';
+					appendInt(out, integerWeight(w));
+					out += ' ';
+				});
+				if (out.size() > lineStart)
+					out.resize(out.size() - 1);	// trailing blank
+				out += '\n';
+				continue;
+			}
+
+			rows(x, [&out, x, base, this](int y, double w) {
+				if (format == DIMACS)
+					out += "a ";
+				appendInt(out, x + base);
+				out += ' ';
+				appendInt(out, y + base);
+				out += ' ';
+				if (format == DIMACS)
+					appendInt(out, integerWeight(w));
+				else
+					appendDouble(out, w);
+				out += '\n';
+			});
+		}
+	}
+
+	template <typename Rows>
+	void GraphWriter::writeRows(const Rows& rows, int V, size_t E) {
+		checkWeights(rows, V);
+		writeHeader(V, E);
+
+		if (threads == 1) {
+			std::string buffer;
+			buffer.reserve(bufferSize + 256);
+			for (int x = 0; x < V; ++x) {
+				formatRows(rows, x, x + 1, buffer);
+				if (buffer.size() >= bufferSize) {
+					os.write(buffer.data(), buffer.size());
+					buffer.clear();
+				}
+			}
+			os.write(buffer.data(), buffer.size());
+			return;
+		}
+
+		// each round formats one block of vertices per thread, then writes the blocks in order
+		size_t bytesPerVertex = 24 * (E / std::max(V, 1)) + 2;
+		int block = std::max<size_t>(1, bufferSize / bytesPerVertex);
+		std::vector<std::string> chunks(threads);
+
+		for (int start = 0; start < V; start += block * threads) {
+			ThreadPool::shared().parallelFor(0, threads, 1, [&](size_t first, size_t last) {
+				for (size_t t = first; t < last; ++t) {
+					int begin = std::min(V, start + (int) t * block);
+					int end = std::min(V, begin + block);
+					chunks[t].clear();
+					formatRows(rows, begin, end, chunks[t]);
+				}
+			}, threads);
+			for (unsigned int t = 0; t < threads; ++t)
+				os.write(chunks[t].data(), chunks[t].size());
+		}
+	}
+}
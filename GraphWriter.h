@@ -0,0 +1,106 @@
+#ifndef GRAPHWRITER_H_
+#define GRAPHWRITER_H_
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Graph.h"
+#include "MST.h"
+
+namespace Algorithms
+{
+	/**
+	 * The {@code GraphWriter} class exports a <code>Graph</code> or the tree
+	 * of an <code>MST</code> in one of the interchange formats:
+	 *
+	 *		1) EDGE_LIST: the native format read by <code>Graph(filename)</code>,
+	 *		   V followed by one "x y w" triple per line
+	 *		2) DIMACS: "p sp V E" followed by "a x y w" arc lines (1-based)
+	 *		3) METIS: "V E 001" followed by one line of "y w" pairs per
+	 *		   vertex (1-based). METIS graphs are undirected, so the edges
+	 *		   are written in both directions and E counts each pair once.
+	 *		4) MATRIX_MARKET: a coordinate real general matrix (1-based)
+	 *
+	 * DIMACS arc lengths and METIS edge weights are integers. By default
+	 * these formats require every weight to be an integer and throw
+	 * otherwise; with a positive weightScale each weight is written as
+	 * w * weightScale rounded to the nearest integer instead.
+	 *
+	 * Output goes through a fixed-size buffer, so nothing proportional to
+	 * the graph is held in memory, and the other formats write weights with
+	 * the shortest representation that reads back to the same double. With
+	 * more than one thread, blocks of vertices are formatted in parallel on
+	 * the shared <code>ThreadPool</code> and written in order.
+	 *
+	 * @programmer Richard Caaya
+	 */
+	class GraphWriter
+	{
+	public:
+
+		enum Format {
+			EDGE_LIST,
+			DIMACS,
+			METIS,
+			MATRIX_MARKET
+		};
+
+		/**
+		 * Initializes a writer.
+		 *
+		 * @param os the stream to write to
+		 * @param format the output format
+		 * @param threads the number of blocks formatted at once on <code>ThreadPool::shared()</code>
+		 * @param bufferSize the number of bytes buffered per thread before writing
+		 * @param weightScale the factor applied to weights before rounding
+		 *        them for DIMACS and METIS (0 = weights must be integers)
+		 */
+		GraphWriter(std::ostream& os, Format format = EDGE_LIST, unsigned int threads = 1,
+				size_t bufferSize = 1 << 16, double weightScale = 0.0);
+
+		/**
+		 * Writes every edge of graph.
+		 *
+		 * @param graph the graph to export
+		 * @throws <code>std::invalid_argument</code> if the format needs
+		 *         integer weights and one is not, before anything is written
+		 */
+		void write(const Graph& graph);
+
+		/**
+		 * Writes the spanning forest computed by mst, as a graph on the
+		 * vertices of the graph it was computed on.
+		 *
+		 * @param mst the minimum spanning tree to export
+		 * @throws <code>std::invalid_argument</code> if the format needs
+		 *         integer weights and one is not, before anything is written
+		 */
+		void write(const MST& mst);
+
+	private:
+		std::ostream& os;
+		Format format;
+		unsigned int threads;
+		size_t bufferSize;
+		double weightScale;
+
+		void writeHeader(int V, size_t E);
+
+		/**
+		 * Returns the integer written for weight w by DIMACS and METIS
+		 */
+		long long integerWeight(double w) const;
+
+		template <typename Rows>
+		void checkWeights(const Rows& rows, int V) const;
+
+		template <typename Rows>
+		void writeRows(const Rows& rows, int V, size_t E);
+
+		template <typename Rows>
+		void formatRows(const Rows& rows, int begin, int end, std::string& out) const;
+	};
+}
+
+#endif /* GRAPHWRITER_H_ */
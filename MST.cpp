@@ -7,36 +7,278 @@
  */
 
 #include "MST.h"
+#include "ScratchArena.h"
 #include <cassert>
 #include <limits>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
 
 namespace Algorithms
 {
-	MST::MST(Graph& graph) :
-		edgeTo(std::vector<Edge<int>* >(graph.getV())),
-		distTo(std::vector<double>(graph.getV(), std::numeric_limits<double>::max())),
-		marked(std::vector<bool>(graph.getV())),
-		pq(graph.getV())
+	/**
+	 * Lowers key[i] to row[i] (and via[i] to rowVia[i], or to rowValue if
+	 * rowVia is NULL) wherever row[i] is smaller, and returns the smallest key
+	 * afterwards. Tree vertices hold NaN keys: every comparison against NaN is
+	 * false, so they are neither relaxed nor selected, without a separate
+	 * marked[] test in the loop.
+	 */
+	static double relaxAndMin(const double* row, const intptr_t* rowVia, intptr_t rowValue,
+			double* key, intptr_t* via, int n) {
+		double best = std::numeric_limits<double>::max();
+		int i = 0;
+
+#if defined(__AVX512F__)
+		__m512d best8 = _mm512_set1_pd(best);
+		for (; i + 8 <= n; i += 8) {
+			__m512d r = _mm512_loadu_pd(row + i);
+			__m512d k = _mm512_loadu_pd(key + i);
+			__mmask8 lt = _mm512_cmp_pd_mask(r, k, _CMP_LT_OQ);
+			if (lt) {
+				k = _mm512_mask_mov_pd(k, lt, r);
+				_mm512_storeu_pd(key + i, k);
+				__m512i rv = rowVia ? _mm512_loadu_si512(rowVia + i) : _mm512_set1_epi64(rowValue);
+				_mm512_mask_storeu_epi64(via + i, lt, rv);
+			}
+			best8 = _mm512_min_pd(k, best8);	// MINPD returns the second operand on NaN
+		}
+		best = _mm512_reduce_min_pd(best8);
+#elif defined(__AVX2__)
+		__m256d best4 = _mm256_set1_pd(best);
+		for (; i + 4 <= n; i += 4) {
+			__m256d r = _mm256_loadu_pd(row + i);
+			__m256d k = _mm256_loadu_pd(key + i);
+			__m256d lt = _mm256_cmp_pd(r, k, _CMP_LT_OQ);
+			if (_mm256_movemask_pd(lt)) {
+				k = _mm256_blendv_pd(k, r, lt);
+				_mm256_storeu_pd(key + i, k);
+				__m256d e = _mm256_castsi256_pd(_mm256_loadu_si256((const __m256i*) (via + i)));
+				__m256d rv = _mm256_castsi256_pd(rowVia ? _mm256_loadu_si256((const __m256i*) (rowVia + i))
+						: _mm256_set1_epi64x(rowValue));
+				_mm256_storeu_si256((__m256i*) (via + i), _mm256_castpd_si256(_mm256_blendv_pd(e, rv, lt)));
+			}
+			best4 = _mm256_min_pd(k, best4);	// MINPD returns the second operand on NaN
+		}
+		__m128d half = _mm_min_pd(_mm256_castpd256_pd128(best4), _mm256_extractf128_pd(best4, 1));
+		best = _mm_cvtsd_f64(_mm_min_sd(half, _mm_unpackhi_pd(half, half)));
+#endif
+
+		for (; i < n; i++) {
+			if (row[i] < key[i]) {
+				key[i] = row[i];
+				via[i] = rowVia ? rowVia[i] : rowValue;
+			}
+			if (key[i] < best)
+				best = key[i];
+		}
+		return best;
+	}
+
+	/**
+	 * Returns the first index i with key[i] == value, or -1.
+	 */
+	static int indexOf(const double* key, int n, double value) {
+		int i = 0;
+
+#if defined(__AVX2__)
+		__m256d v = _mm256_set1_pd(value);
+		for (; i + 4 <= n; i += 4) {
+			int eq = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(key + i), v, _CMP_EQ_OQ));
+			if (eq)
+				return i + __builtin_ctz(eq);
+		}
+#endif
+
+		for (; i < n; i++)
+			if (key[i] == value)
+				return i;
+		return -1;
+	}
+
+	MST::MST(const Graph& graph, Strategy strategy) :
+		edgeTo(ScratchArena::local().acquire<Edge<int>*>(graph.getV(), NULL)),
+		distTo(ScratchArena::local().acquire<double>(graph.getV(), std::numeric_limits<double>::max())),
+		marked(ScratchArena::local().acquire<bool>(graph.getV(), false)),
+		pq(0)
 	{
+		std::vector<PriorityQueue<double>::HeapEntry> storage = ScratchArena::local().acquire<PriorityQueue<double>::HeapEntry>(graph.getV() + 1);
+		pq.swapStorage(storage);
+
+		if (strategy == AUTO) {
+			double maxEdges = (double) graph.getV() * (graph.getV() - 1) / 2;
+			bool dense = graph.getRepresentation() == Graph::ADJACENCY_MATRIX
+					|| graph.getE() >= DENSE_GRAPH_DENSITY * maxEdges;
+			strategy = dense ? DENSE : HEAP;
+		}
+
+		if (strategy == DENSE) {
+			densePrim(graph);
+			return;
+		}
+
 		for (int v = 0; v < graph.getV(); v++)     	// run from each vertex to find
 			if (!marked[v])
 				prim(graph, v);    					// minimum spanning forest
 	}
 
-	void MST::prim(Graph& g, int s) {
+	MST::MST(const CompressedGraph& graph) :
+		edgeTo(ScratchArena::local().acquire<Edge<int>*>(graph.getV(), NULL)),
+		distTo(ScratchArena::local().acquire<double>(graph.getV(), std::numeric_limits<double>::max())),
+		marked(ScratchArena::local().acquire<bool>(graph.getV(), false)),
+		pq(0)
+	{
+		lazyPrim(graph);
+	}
+
+	MST::MST(const ConcurrentGraph::Version& graph) :
+		edgeTo(ScratchArena::local().acquire<Edge<int>*>(graph.getV(), NULL)),
+		distTo(ScratchArena::local().acquire<double>(graph.getV(), std::numeric_limits<double>::max())),
+		marked(ScratchArena::local().acquire<bool>(graph.getV(), false)),
+		pq(0)
+	{
+		lazyPrim(graph);
+	}
+
+	template <typename G>
+	void MST::lazyPrim(const G& graph) {
+		ScratchArena& arena = ScratchArena::local();
+		std::vector<PriorityQueue<double>::HeapEntry> storage = arena.acquire<PriorityQueue<double>::HeapEntry>(graph.getV() + 1);
+		pq.swapStorage(storage);
+		std::vector<int> parent = arena.acquire<int>(graph.getV(), -1);	// there are no Edge objects to point at
+
+		for (int s = 0; s < graph.getV(); s++) {
+			if (marked[s])
+				continue;
+
+			distTo[s] = 0.0;
+			pq.push(s, distTo[s]);
+			while (!pq.isEmpty()) {
+				int v = pq.top();
+				pq.pop();
+				if (marked[v])
+					continue;
+				marked[v] = true;
+
+				graph.forEachNeighbor(v, [&](int w, double weight) {
+					if (!marked[w] && weight < distTo[w]) {
+						distTo[w] = weight;
+						parent[w] = v;
+						pq.push(w, distTo[w]);
+					}
+				});
+			}
+		}
+
+		for (int v = 0; v < graph.getV(); v++) {
+			if (parent[v] >= 0) {
+				edgeTo[v] = new Edge<int>(new Node<int>(parent[v]), new Node<int>(v), distTo[v]);
+				ownedEdges.push_back(edgeTo[v]);
+			}
+		}
+		arena.release(parent);
+	}
+
+	void MST::prim(const Graph& g, int s) {
 		distTo[s] = 0.0;
 		pq.push(s, distTo[s]);
 
 		while (!pq.isEmpty()) {
 			int v = pq.top(); //pq.delMin();
 			pq.pop();
+			if (marked[v])
+				continue;	// stale entry, v was reached again through a lighter edge
 			scan(g, v);
 		}
 	}
 
-	void MST::scan(Graph& g, int v) {
+	MST::~MST() {
+		for (Edge<int>* e : ownedEdges)
+			delete e;
+
+		// hand the buffers to the next MST on this thread
+		ScratchArena& arena = ScratchArena::local();
+		std::vector<PriorityQueue<double>::HeapEntry> storage;
+		pq.swapStorage(storage);
+		arena.release(storage);
+		arena.release(edgeTo);
+		arena.release(distTo);
+		arena.release(marked);
+	}
+
+	void MST::densePrim(const Graph& g) {
+		const int V = g.getV();
+		const double NONE = std::numeric_limits<double>::max();
+		const bool matrix = g.getRepresentation() == Graph::ADJACENCY_MATRIX;
+
+		// a matrix graph supplies each row directly; a list graph is scattered into row[]
+		ScratchArena& arena = ScratchArena::local();
+		std::vector<double> key = arena.acquire<double>(V, NONE);			// key[v] = weight of the lightest edge from the tree to v, NaN once v is on the tree
+		std::vector<intptr_t> via = arena.acquire<intptr_t>(V, -1);			// the Edge* behind key[v] (lists) or the tree end-point of it (matrix)
+		std::vector<double> row = arena.acquire<double>(matrix ? 0 : V, std::numeric_limits<double>::infinity());
+		std::vector<intptr_t> rowVia = arena.acquire<intptr_t>(matrix ? 0 : V);
+
+		int nextRoot = 0;
+		double best = NONE;
+
+		for (int added = 0; added < V; added++) {
+			int v = (best < NONE) ? indexOf(&key[0], V, best) : -1;
+			if (v < 0) {
+				// nothing reachable from the current tree: start the next component
+				while (marked[nextRoot])
+					nextRoot++;
+				v = nextRoot;
+				distTo[v] = 0.0;
+			}
+			else {
+				distTo[v] = key[v];
+			}
+
+			marked[v] = true;
+			key[v] = std::numeric_limits<double>::quiet_NaN();
+
+			if (matrix) {
+				best = relaxAndMin(g.getWeightRow(v), NULL, v, &key[0], &via[0], V);
+				continue;
+			}
+
+			const Graph::listOfEdges& edges = g.getAdjacencyList()[v];
+			for (Edge<int>* e : edges) {
+				int w = e->other(v);
+				if (!marked[w] && e->getWeight() < row[w]) {
+					row[w] = e->getWeight();
+					rowVia[w] = (intptr_t) e;
+				}
+			}
+
+			best = relaxAndMin(&row[0], &rowVia[0], 0, &key[0], &via[0], V);
+
+			for (Edge<int>* e : edges)
+				row[e->other(v)] = std::numeric_limits<double>::infinity();
+		}
+
+		for (int v = 0; v < V; v++) {
+			if (via[v] == -1)
+				continue;
+			if (matrix) {
+				edgeTo[v] = new Edge<int>(new Node<int>(via[v]), new Node<int>(v), distTo[v]);
+				ownedEdges.push_back(edgeTo[v]);
+			}
+			else {
+				edgeTo[v] = (Edge<int>*) via[v];
+			}
+		}
+
+		arena.release(key);
+		arena.release(via);
+		arena.release(row);
+		arena.release(rowVia);
+	}
+
+	void MST::scan(const Graph& g, int v) {
 		marked[v] = true;
-		std::vector<std::list<Edge<int>*> > adj = g.getAdjacencyList();
+		const std::vector<std::list<Edge<int>*> >& adj = g.getAdjacencyList();
 
 		for (Edge<int>* e : adj[v]) {
 			int w = e->other(v);
@@ -45,15 +287,12 @@ namespace Algorithms
 			if (e->getWeight() < distTo[w]) {
 				distTo[w] = e->getWeight();
 				edgeTo[w] = e;
-				if (pq.contains(w))
-					pq.changePriority(w, distTo[w]);
-				else
-					pq.push(w, distTo[w]);
+				pq.push(w, distTo[w]);	// the older entry for w is skipped when popped
 			}
 		}
 	}
 
-	const std::vector<Edge<int>* > MST::edges() {
+	const std::vector<Edge<int>* > MST::edges() const {
 		std::vector<Edge<int>*> mst;
 		for (unsigned int v = 0; v < edgeTo.size(); v++) {
 			Edge<int>* e = edgeTo[v];
@@ -64,10 +303,11 @@ namespace Algorithms
 		return mst;
 	}
 
-	double MST::cost() {
+	double MST::cost() const {
 		double weight = 0.0;
-		for (Edge<int>* e : edges())
-			weight += e->getWeight();
+		for (Edge<int>* e : edgeTo)
+			if (e != NULL)
+				weight += e->getWeight();
 		return weight;
 	}
 }
@@ -2,27 +2,77 @@
 #define MST_H_
 
 #include "Graph.h"
+#include "CompressedGraph.h"
+#include "ConcurrentGraph.h"
 #include "PriorityQueue.h"
 
 namespace Algorithms
 {
+	/**
+	 * A graph is treated as dense, and solved with the array-based Prim,
+	 * once it has at least this fraction of the V(V-1)/2 possible edges.
+	 */
+	const double DENSE_GRAPH_DENSITY = 0.5;
+
 	/**
 	 * The {@code MST} class represents a data type for computing a
 	 * <em>minimum spanning tree</em> in an edge-weighted graph
 	 * using Prim's greedy algorithm.
 	 *
+	 * Sparse graphs use the binary-heap variant in O(E log V) time. Dense
+	 * graphs use the classic array variant in O(V^2) time, whose arg-min and
+	 * distance updates are vectorized with AVX2/AVX-512 when the compiler
+	 * targets them (scalar otherwise). On a graph in the adjacency-matrix
+	 * representation the array variant reads the weight rows directly and
+	 * the edges returned by <code>edges()</code> belong to this object.
+	 *
+	 * The working arrays come from the calling thread's
+	 * <code>ScratchArena</code> and go back to it when the object is
+	 * destroyed, so repeated solves on one thread, such as jobs on a
+	 * <code>ThreadPool</code> worker, reuse the same memory.
+	 *
 	 * @programmer Richard Caaya
 	 */
 	class MST
 	{
 	public:
 
+		enum Strategy {
+			AUTO,	// DENSE when the graph reaches DENSE_GRAPH_DENSITY, HEAP otherwise
+			HEAP,	// binary-heap Prim
+			DENSE	// array Prim with a vectorized min-scan
+		};
+
 		/**
 		 * Compute a minimum spanning tree of an edge-weighted graph.
 		 *
 		 * @param graph the edge-weighted graph
+		 * @param strategy which variant of Prim's algorithm to run
 		 */
-		MST(Graph& graph);
+		MST(const Graph& graph, Strategy strategy = AUTO);
+
+		/**
+		 * Compute a minimum spanning tree of a compressed graph, decoding
+		 * each row as it is scanned. The edges returned by
+		 * <code>edges()</code> belong to this object.
+		 *
+		 * @param graph the compressed edge-weighted graph
+		 */
+		MST(const CompressedGraph& graph);
+
+		/**
+		 * Compute a minimum spanning tree of one version of a
+		 * <code>ConcurrentGraph</code>, such as a reader's snapshot. The
+		 * edges returned by <code>edges()</code> belong to this object.
+		 *
+		 * @param graph the version to solve
+		 */
+		MST(const ConcurrentGraph::Version& graph);
+
+		/**
+		 * Destructor
+		 */
+		~MST();
 
 		/**
 		 * Runs Prim's algorithm
@@ -30,7 +80,7 @@ namespace Algorithms
 		 * @param Graph g The graph
 		 * @param s The source vertex
 		 */
-		void prim(Graph& g, int s);
+		void prim(const Graph& g, int s);
 
 		/**
 		 * Scan vertex v
@@ -38,25 +88,50 @@ namespace Algorithms
 		 * @param g The graph
 		 * @param v The vertex to scan
 		 */
-		void scan(Graph& g, int v);
+		void scan(const Graph& g, int v);
+
+		/**
+		 * Runs the O(V^2) array variant of Prim's algorithm over every
+		 * component of the graph
+		 *
+		 * @param g The graph
+		 */
+		void densePrim(const Graph& g);
+
+		/**
+		 * Returns the number of vertices of the graph this tree spans.
+		 * @return the number of vertices
+		 */
+		inline int getV() const { return (int) this->edgeTo.size(); }
 
 		/**
 		 * Returns the edges in a minimum spanning tree
 		 * @return the edges in a minimum spanning tree as a vector of edges
 		 */
-		const std::vector<Edge<int>*> edges();
+		const std::vector<Edge<int>*> edges() const;
 
 		/**
 		 * Returns the sum of the edge weights in a minimum spanning tree.
 		 * @return the total cost
 		 */
-		double cost();
+		double cost() const;
 
 	private:
 		std::vector<Edge<int>* > edgeTo;   	// edgeTo[v] = shortest edge from tree vertex to non-tree vertex
 		std::vector<double> distTo;    		// distTo[v] = weight of shortest such edge
 		std::vector<bool> marked;			// marked[v] = true if v on tree, false otherwise
 		PriorityQueue<double> pq;			// A min heap of priorities
+		std::vector<Edge<int>* > ownedEdges;	// tree edges allocated here because the graph has no Edge for them
+
+		/**
+		 * Runs the binary-heap Prim over a graph that only offers
+		 * forEachNeighbor, recording the tree in ownedEdges
+		 */
+		template <typename G>
+		void lazyPrim(const G& graph);
+
+		MST(const MST&);					// not copyable: ownedEdges
+		MST& operator=(const MST&);
 	};
 }
 
@@ -0,0 +1,240 @@
+/**
+ * MSTVerifier.cpp
+ *
+ *  Programmer: Richard Caaya
+ */
+
+#include "MSTVerifier.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace Algorithms
+{
+	static int findRoot(std::vector<int>& parent, int v) {
+		while (parent[v] != v) {
+			parent[v] = parent[parent[v]];
+			v = parent[v];
+		}
+		return v;
+	}
+
+	/**
+	 * Union-find whose links follow the forest towards the root and carry
+	 * the heaviest weight along them. Compressing a path keeps that maximum.
+	 */
+	class PathMaxima {
+	public:
+		PathMaxima(int V) : link(V), up(V, -std::numeric_limits<double>::infinity()) {
+			for (int v = 0; v < V; ++v)
+				link[v] = v;
+		}
+
+		/**
+		 * Hangs the finished subtree of child below parent through an edge of weight w
+		 */
+		void attach(int child, int parent, double w) {
+			link[child] = parent;
+			up[child] = w;
+		}
+
+		/**
+		 * Returns the lowest ancestor of v whose subtree is still open
+		 */
+		int root(int v) {
+			compress(v);
+			return link[v] == v ? v : link[v];
+		}
+
+		/**
+		 * Returns the heaviest edge from v up to root(v)
+		 */
+		double max(int v) {
+			compress(v);
+			return link[v] == v ? -std::numeric_limits<double>::infinity() : up[v];
+		}
+
+	private:
+		std::vector<int> link;
+		std::vector<double> up;		// heaviest edge from v up to link[v]
+		std::vector<int> path;
+
+		void compress(int v) {
+			path.clear();
+			while (link[v] != v) {
+				path.push_back(v);
+				v = link[v];
+			}
+			// path[i] links to path[i + 1], the last one to the root v
+			for (int i = (int) path.size() - 2; i >= 0; --i) {
+				up[path[i]] = std::max(up[path[i]], up[path[i + 1]]);
+				link[path[i]] = v;
+			}
+		}
+	};
+
+	MSTVerifier::MSTVerifier(const Graph& graph, const std::vector<Edge<int>*>& forest) : spanning(true) {
+		const int V = graph.getV();
+
+		// the forest must be acyclic
+		std::vector<int> forestSets(V), graphSets(V);
+		for (int v = 0; v < V; ++v)
+			forestSets[v] = graphSets[v] = v;
+
+		int forestComponents = V, graphComponents = V;
+		std::vector<size_t> offsets(V + 1, 0);
+		std::vector<const Edge<int>*> accepted;
+		for (const Edge<int>* e : forest) {
+			int x = e->getX()->getValue(), y = e->getY()->getValue();
+			if (x < 0 || x >= V || y < 0 || y >= V) {
+				spanning = false;
+				continue;
+			}
+			int rx = findRoot(forestSets, x), ry = findRoot(forestSets, y);
+			if (rx == ry) {
+				spanning = false;
+				continue;
+			}
+			forestSets[rx] = ry;
+			forestComponents--;
+			accepted.push_back(e);
+			offsets[x + 1]++;
+			offsets[y + 1]++;
+		}
+
+		std::vector<int> tree(V);				// tree[v] = the tree holding v
+		for (int v = 0; v < V; ++v)
+			tree[v] = findRoot(forestSets, v);
+
+		// forest adjacency of the edges accepted above, each row sorted by neighbor
+		struct Arc {
+			int to;
+			int edge;
+			double weight;
+
+			bool operator<(const Arc& other) const { return to < other.to; }
+		};
+		for (int v = 0; v < V; ++v)
+			offsets[v + 1] += offsets[v];
+		std::vector<Arc> arcs(offsets[V]);
+		{
+			std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+			for (size_t i = 0; i < accepted.size(); ++i) {
+				int x = accepted[i]->getX()->getValue(), y = accepted[i]->getY()->getValue();
+				Arc toY = { y, (int) i, accepted[i]->getWeight() };
+				Arc toX = { x, (int) i, accepted[i]->getWeight() };
+				arcs[next[x]++] = toY;
+				arcs[next[y]++] = toX;
+			}
+			for (int v = 0; v < V; ++v)
+				std::sort(arcs.begin() + offsets[v], arcs.begin() + offsets[v + 1]);
+		}
+		std::vector<char> inGraph(accepted.size(), 0);
+
+		// the graph must contain the forest and connect exactly what it
+		// connects, and every graph edge inside a tree is a path-maximum query
+		struct Query {
+			int x;
+			int y;
+			double weight;
+		};
+		std::vector<Query> queries;
+		queries.reserve(graph.getE());
+		std::vector<size_t> queryOffsets(V + 1, 0);
+		for (int x = 0; x < V; ++x) {
+			graph.forEachNeighbor(x, [&](int y, double w) {
+				int rx = findRoot(graphSets, x), ry = findRoot(graphSets, y);
+				if (rx != ry) {
+					graphSets[rx] = ry;
+					graphComponents--;
+				}
+				if (x == y || tree[x] != tree[y])
+					return;		// loops never violate; edges across trees fail the component count
+
+				Arc key = { y, 0, 0.0 };
+				std::vector<Arc>::const_iterator arc = std::lower_bound(arcs.begin() + offsets[x], arcs.begin() + offsets[x + 1], key);
+				if (arc != arcs.begin() + offsets[x + 1] && arc->to == y && arc->weight == w)
+					inGraph[arc->edge] = 1;		// a forest edge must carry the weight it has in the graph
+
+				Query q = { x, y, w };
+				queries.push_back(q);
+				queryOffsets[x + 1]++;
+				queryOffsets[y + 1]++;
+			});
+		}
+		if (forestComponents != graphComponents
+				|| std::find(inGraph.begin(), inGraph.end(), 0) != inGraph.end())
+			spanning = false;
+
+		// queriesAt lists, for each vertex, (other end-point, query) of its queries
+		for (int v = 0; v < V; ++v)
+			queryOffsets[v + 1] += queryOffsets[v];
+		std::vector<std::pair<int, int> > queriesAt(queryOffsets[V]);
+		{
+			std::vector<size_t> next(queryOffsets.begin(), queryOffsets.end() - 1);
+			for (size_t i = 0; i < queries.size(); ++i) {
+				queriesAt[next[queries[i].x]++] = std::make_pair(queries[i].y, (int) i);
+				queriesAt[next[queries[i].y]++] = std::make_pair(queries[i].x, (int) i);
+			}
+		}
+
+		// Tarjan's offline LCA: a query is answered at the LCA once both end-points are finished
+		PathMaxima maxima(V);
+		std::vector<char> state(V, 0);				// 0 = unvisited, 1 = on the stack, 2 = finished
+		std::vector<int> firstAt(V, -1);			// queries waiting at their LCA, as linked lists
+		std::vector<int> nextAt(queries.size(), -1);
+		std::vector<int> parent(V, -1);
+		std::vector<double> parentWeight(V, 0.0);
+		std::vector<std::pair<int, size_t> > stack;	// (vertex, next tree edge)
+
+		for (int root = 0; root < V; ++root) {
+			if (state[root] != 0)
+				continue;
+			state[root] = 1;
+			stack.push_back(std::make_pair(root, offsets[root]));
+
+			while (!stack.empty()) {
+				int v = stack.back().first;
+				size_t& edge = stack.back().second;
+
+				if (edge < offsets[v + 1]) {
+					int w = arcs[edge].to;
+					double weight = arcs[edge].weight;
+					edge++;
+					if (state[w] == 0) {
+						state[w] = 1;
+						parent[w] = v;
+						parentWeight[w] = weight;
+						stack.push_back(std::make_pair(w, offsets[w]));
+					}
+					continue;
+				}
+
+				// all children of v are finished and hang below it
+				state[v] = 2;
+				for (size_t i = queryOffsets[v]; i < queryOffsets[v + 1]; ++i) {
+					int other = queriesAt[i].first;
+					if (state[other] == 2) {
+						int lca = maxima.root(other);
+						nextAt[queriesAt[i].second] = firstAt[lca];
+						firstAt[lca] = queriesAt[i].second;
+					}
+				}
+
+				for (int i = firstAt[v]; i >= 0; i = nextAt[i]) {
+					const Query& q = queries[i];
+					double pathMax = std::max(maxima.max(q.x), maxima.max(q.y));
+					if (q.weight < pathMax) {
+						Violation violation = { q.x, q.y, q.weight, pathMax };
+						found.push_back(violation);
+					}
+				}
+
+				if (parent[v] >= 0)
+					maxima.attach(v, parent[v], parentWeight[v]);
+				stack.pop_back();
+			}
+		}
+	}
+}
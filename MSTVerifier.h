@@ -0,0 +1,76 @@
+#ifndef MSTVERIFIER_H_
+#define MSTVERIFIER_H_
+
+#include <vector>
+
+#include "Graph.h"
+
+namespace Algorithms
+{
+	/**
+	 * The {@code MSTVerifier} class checks that a set of edges is a minimum
+	 * spanning forest of a graph without computing one.
+	 *
+	 * The candidate is a spanning forest if it has no cycle, uses only
+	 * edges of the graph with the weights they have there, and connects
+	 * exactly what the graph connects. It
+	 * is minimum if it satisfies the cycle property: no edge x-y of the
+	 * graph is lighter than the heaviest edge on the forest path from x to
+	 * y.
+	 *
+	 * Path maxima are answered offline in one depth-first pass over the
+	 * forest. Tarjan's LCA algorithm finds the lowest common ancestor of
+	 * each edge's end-points, and a union-find with path compression that
+	 * carries the maximum weight along each compressed link finds the
+	 * heaviest edge from each end-point up to that ancestor. The whole
+	 * check takes O((V + E) log V) time, usually close to linear.
+	 *
+	 * @programmer Richard Caaya
+	 */
+	class MSTVerifier
+	{
+	public:
+
+		/**
+		 * A graph edge that is lighter than the forest path between its end-points
+		 */
+		struct Violation {
+			int x;
+			int y;
+			double weight;		// weight of the edge x-y
+			double pathMax;		// heaviest edge on the forest path from x to y
+		};
+
+		/**
+		 * Verifies forest against graph.
+		 *
+		 * @param graph the edge-weighted graph
+		 * @param forest the candidate minimum spanning forest, e.g. <code>MST::edges()</code>
+		 */
+		MSTVerifier(const Graph& graph, const std::vector<Edge<int>*>& forest);
+
+		/**
+		 * Returns true if the candidate is a spanning forest of the graph.
+		 * @return <code>true</code> if acyclic, made of graph edges of the same weight and spanning
+		 */
+		bool isSpanningForest() const { return this->spanning; }
+
+		/**
+		 * Returns true if the candidate is a minimum spanning forest.
+		 * @return <code>true</code> if it is a spanning forest with no violations
+		 */
+		bool isValid() const { return this->spanning && this->found.empty(); }
+
+		/**
+		 * Returns the graph edges that violate the cycle property.
+		 * @return the violating edges
+		 */
+		const std::vector<Violation>& violations() const { return this->found; }
+
+	private:
+		bool spanning;
+		std::vector<Violation> found;
+	};
+}
+
+#endif /* MSTVERIFIER_H_ */
@@ -0,0 +1,429 @@
+/**
+ * PartitionedMST.cpp
+ *
+ *  Programmer: Richard Caaya
+ */
+
+#include "PartitionedMST.h"
+#include "MST.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <stdint.h>
+
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace Algorithms
+{
+	/**
+	 * An edge as it travels between processes
+	 */
+	struct WireEdge {
+		int32_t x;
+		int32_t y;
+		double weight;
+	};
+
+	/**
+	 * Orders edges by weight, then by end-points, so that every process
+	 * agrees on the lightest edge and Boruvka never closes a cycle.
+	 */
+	static bool lighter(const WireEdge& a, const WireEdge& b) {
+		if (a.weight != b.weight)
+			return a.weight < b.weight;
+		int aLow = std::min(a.x, a.y), bLow = std::min(b.x, b.y);
+		if (aLow != bLow)
+			return aLow < bLow;
+		return std::max(a.x, a.y) < std::max(b.x, b.y);
+	}
+
+	template <typename T>
+	static std::vector<char> encode(const std::vector<T>& items) {
+		std::vector<char> message(items.size() * sizeof(T));
+		if (!items.empty())
+			memcpy(&message[0], &items[0], message.size());
+		return message;
+	}
+
+	template <typename T>
+	static std::vector<T> decode(const std::vector<char>& message) {
+		std::vector<T> items(message.size() / sizeof(T));
+		if (!items.empty())
+			memcpy(&items[0], &message[0], items.size() * sizeof(T));
+		return items;
+	}
+
+	class UnionFind {
+	public:
+		UnionFind(int V) : parent(V) {
+			for (int v = 0; v < V; ++v)
+				parent[v] = v;
+		}
+
+		int find(int v) {
+			while (parent[v] != v) {
+				parent[v] = parent[parent[v]];	// path halving
+				v = parent[v];
+			}
+			return v;
+		}
+
+		bool unite(int x, int y) {
+			x = find(x);
+			y = find(y);
+			if (x == y)
+				return false;
+			parent[std::max(x, y)] = std::min(x, y);
+			return true;
+		}
+
+	private:
+		std::vector<int> parent;
+	};
+
+	/**
+	 * For each component touched by edges, remembers the index of its lightest outgoing edge
+	 */
+	class LightestEdges {
+	public:
+		LightestEdges(size_t components) : best(components, -1) {}
+
+		void offer(int component, const std::vector<WireEdge>& edges, int index) {
+			if (best[component] < 0)
+				components.push_back(component);
+			else if (!lighter(edges[index], edges[best[component]]))
+				return;
+			best[component] = index;
+		}
+
+		/**
+		 * Returns the chosen indices and forgets them
+		 */
+		std::vector<int> take() {
+			std::vector<int> chosen;
+			chosen.reserve(components.size());
+			for (int c : components) {
+				chosen.push_back(best[c]);
+				best[c] = -1;
+			}
+			components.clear();
+			std::sort(chosen.begin(), chosen.end());
+			chosen.erase(std::unique(chosen.begin(), chosen.end()), chosen.end());
+			return chosen;
+		}
+
+	private:
+		std::vector<int> best;
+		std::vector<int> components;
+	};
+
+	static const size_t SHARD_MESSAGE = 1 << 16;		// edges per message when the coordinator sends a range
+
+	/**
+	 * Collects the edges from one range: the ones inside it go into a
+	 * local graph, the ones leaving it are candidates as they are
+	 */
+	class Shard {
+	public:
+		Shard(int lo, int hi) : lo(lo), hi(hi), inside(hi - lo, Graph::ADJACENCY_LISTS) {}
+
+		void add(int x, int y, double w) {
+			if (y == x)
+				return;
+			if (y >= lo && y < hi) {
+				inside.addEdge(x - lo, y - lo, w);
+				inside.addEdge(y - lo, x - lo, w);
+			}
+			else {
+				WireEdge e = { x, y, w };
+				candidates.push_back(e);
+			}
+		}
+
+		/**
+		 * Returns the candidates: the edges leaving the range and the
+		 * minimum spanning forest of the edges inside it
+		 */
+		std::vector<WireEdge>& finish() {
+			MST local(inside);
+			for (const Edge<int>* edge : local.edges()) {
+				WireEdge e = { edge->getX()->getValue() + lo, edge->getY()->getValue() + lo, edge->getWeight() };
+				candidates.push_back(e);
+			}
+			return candidates;
+		}
+
+	private:
+		int lo;
+		int hi;
+		Graph inside;
+		std::vector<WireEdge> candidates;
+	};
+
+	static void runWorker(Transport& transport, int rank, int V, int lo, int hi, bool fromFile, const std::string& filename) {
+		transport.attach(rank);
+
+		std::vector<WireEdge> candidates;
+		{
+			// edges inside the range only matter if they are in its local forest
+			Shard shard(lo, hi);
+			if (fromFile) {
+				std::ifstream in(filename.c_str());
+				if (!in.is_open())
+					throw std::runtime_error("Cannot open " + filename);
+				long long x, y;
+				double w;
+				in >> x;				// V
+				while (in >> x >> y >> w) {
+					if (x >= lo && x < hi && y >= 0 && y < V)
+						shard.add((int) x, (int) y, w);
+				}
+			}
+			else {
+				for (;;) {
+					std::vector<WireEdge> some = decode<WireEdge>(transport.receive(0));
+					if (some.empty())
+						break;
+					for (const WireEdge& e : some)
+						shard.add(e.x, e.y, e.weight);
+				}
+			}
+			candidates.swap(shard.finish());
+		}
+
+		// number the vertices the candidates touch; the order of the ids is
+		// kept, so lighter() breaks ties the same way on local ids
+		std::vector<int32_t> ids;
+		ids.reserve(2 * candidates.size());
+		for (const WireEdge& e : candidates) {
+			ids.push_back(e.x);
+			ids.push_back(e.y);
+		}
+		std::sort(ids.begin(), ids.end());
+		ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+		for (WireEdge& e : candidates) {
+			e.x = std::lower_bound(ids.begin(), ids.end(), e.x) - ids.begin();
+			e.y = std::lower_bound(ids.begin(), ids.end(), e.y) - ids.begin();
+		}
+		transport.send(0, encode(ids));
+
+		// label[i] = the smallest local id in the component of local vertex i
+		std::vector<int> label(ids.size());
+		for (size_t i = 0; i < label.size(); ++i)
+			label[i] = i;
+		LightestEdges lightest(ids.size());
+
+		for (;;) {
+			// drop edges inside a component, and find each component's lightest way out
+			size_t kept = 0;
+			for (size_t i = 0; i < candidates.size(); ++i) {
+				int cx = label[candidates[i].x];
+				int cy = label[candidates[i].y];
+				if (cx == cy)
+					continue;
+				candidates[kept] = candidates[i];
+				lightest.offer(cx, candidates, kept);
+				lightest.offer(cy, candidates, kept);
+				kept++;
+			}
+			candidates.resize(kept);
+
+			std::vector<WireEdge> proposals;
+			for (int i : lightest.take()) {
+				WireEdge e = { ids[candidates[i].x], ids[candidates[i].y], candidates[i].weight };
+				proposals.push_back(e);
+			}
+			transport.send(0, encode(proposals));
+
+			// (more, then pairs of local id and new label)
+			std::vector<int32_t> relabel = decode<int32_t>(transport.receive(0));
+			if (relabel.empty() || relabel[0] == 0)
+				break;
+			for (size_t i = 1; i + 1 < relabel.size(); i += 2)
+				label[relabel[i]] = relabel[i + 1];
+		}
+	}
+
+	PartitionedMST::PartitionedMST(const Graph& graph, Transport& transport) : roundCount(0) {
+		run(graph.getV(), transport, &graph, std::string());
+	}
+
+	PartitionedMST::PartitionedMST(const std::string& filename, Transport& transport) : roundCount(0) {
+		std::ifstream in(filename.c_str());
+		if (!in.is_open()) {
+			std::cout << "File: " << filename << " not found! Aborting!" << std::endl;
+			exit(0);
+		}
+		int V = 0;
+		in >> V;
+		in.close();
+
+		run(V, transport, NULL, filename);
+	}
+
+	void PartitionedMST::run(int V, Transport& transport, const Graph* graph, const std::string& filename) {
+		const int workers = transport.size() - 1;
+		if (workers < 1)
+			throw std::invalid_argument("PartitionedMST needs at least one worker");
+
+		std::vector<pid_t> pids;
+		for (int rank = 1; rank <= workers; ++rank) {
+			pid_t pid = fork();
+			if (pid < 0) {
+				for (pid_t started : pids)
+					kill(started, SIGKILL);
+				for (pid_t started : pids)
+					waitpid(started, NULL, 0);
+				throw std::runtime_error("Cannot fork a worker");
+			}
+			if (pid == 0) {
+				int status = 0;
+				try {
+					runWorker(transport, rank, V, (long long) V * (rank - 1) / workers, (long long) V * rank / workers,
+							graph == NULL, filename);
+				}
+				catch (...) {
+					status = 1;
+				}
+				_exit(status);
+			}
+			pids.push_back(pid);
+			transport.setProcess(rank, pid);
+		}
+
+		try {
+			transport.attach(0);
+
+			// hand each worker the edges from its range, then an empty message
+			if (graph != NULL) {
+				for (int rank = 1; rank <= workers; ++rank) {
+					std::vector<WireEdge> some;
+					for (int x = (long long) V * (rank - 1) / workers; x < (long long) V * rank / workers; ++x) {
+						graph->forEachNeighbor(x, [&](int y, double w) {
+							WireEdge e = { x, y, w };
+							some.push_back(e);
+							if (some.size() == SHARD_MESSAGE) {
+								transport.send(rank, encode(some));
+								some.clear();
+							}
+						});
+					}
+					if (!some.empty())
+						transport.send(rank, encode(some));
+					transport.send(rank, std::vector<char>());
+				}
+			}
+
+			// held[r][i] = the vertex with local id i at worker r, labels[r][i] = its label as last sent
+			std::vector<std::vector<int32_t> > held(workers + 1), labels(workers + 1);
+			for (int rank = 1; rank <= workers; ++rank) {
+				held[rank] = decode<int32_t>(transport.receive(rank));
+				labels[rank].resize(held[rank].size());
+				for (size_t i = 0; i < held[rank].size(); ++i)
+					labels[rank][i] = i;
+			}
+
+			UnionFind components(V);
+			LightestEdges lightest(V);
+			std::vector<int32_t> first(V, -1);		// first[root] = the smallest local id in root's component
+
+			for (;;) {
+				std::vector<WireEdge> proposals;
+				for (int rank = 1; rank <= workers; ++rank) {
+					std::vector<WireEdge> some = decode<WireEdge>(transport.receive(rank));
+					proposals.insert(proposals.end(), some.begin(), some.end());
+				}
+
+				for (size_t i = 0; i < proposals.size(); ++i) {
+					int cx = components.find(proposals[i].x);
+					int cy = components.find(proposals[i].y);
+					if (cx != cy) {
+						lightest.offer(cx, proposals, i);
+						lightest.offer(cy, proposals, i);
+					}
+				}
+
+				bool merged = false;
+				for (int i : lightest.take()) {
+					const WireEdge& e = proposals[i];
+					if (components.unite(e.x, e.y)) {
+						merged = true;
+						tree.push_back(new Edge<int>(new Node<int>(e.x), new Node<int>(e.y), e.weight));
+					}
+				}
+
+				// tell each worker the labels that changed; (0) tells them there is nothing left to merge
+				for (int rank = 1; rank <= workers; ++rank) {
+					std::vector<int32_t> relabel(1, merged ? 1 : 0);
+					if (merged) {
+						const std::vector<int32_t>& vertices = held[rank];
+						for (size_t i = 0; i < vertices.size(); ++i) {
+							int32_t& smallest = first[components.find(vertices[i])];
+							if (smallest < 0)
+								smallest = i;
+							if (labels[rank][i] != smallest) {
+								labels[rank][i] = smallest;
+								relabel.push_back(i);
+								relabel.push_back(smallest);
+							}
+						}
+						for (size_t i = 0; i < vertices.size(); ++i)
+							first[components.find(vertices[i])] = -1;
+					}
+					transport.send(rank, encode(relabel));
+				}
+
+				if (!merged)
+					break;
+				roundCount++;
+			}
+		}
+		catch (...) {
+			for (pid_t pid : pids)
+				kill(pid, SIGKILL);
+			for (pid_t pid : pids)
+				waitpid(pid, NULL, 0);
+			for (Edge<int>* e : tree)
+				delete e;
+			tree.clear();
+			throw;
+		}
+
+		bool failed = false;
+		for (pid_t pid : pids) {
+			int status = 0;
+			if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+				failed = true;
+		}
+		if (failed) {
+			for (Edge<int>* e : tree)
+				delete e;
+			tree.clear();
+			throw std::runtime_error("A worker process failed");
+		}
+	}
+
+	PartitionedMST::~PartitionedMST() {
+		for (Edge<int>* e : tree)
+			delete e;
+	}
+
+	const std::vector<Edge<int>*> PartitionedMST::edges() const {
+		return tree;
+	}
+
+	double PartitionedMST::cost() const {
+		double weight = 0.0;
+		for (Edge<int>* e : tree)
+			weight += e->getWeight();
+		return weight;
+	}
+}
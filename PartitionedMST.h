@@ -0,0 +1,126 @@
+#ifndef PARTITIONEDMST_H_
+#define PARTITIONEDMST_H_
+
+#include <string>
+#include <vector>
+
+#include "Graph.h"
+#include "Transport.h"
+
+namespace Algorithms
+{
+	/**
+	 * The {@code PartitionedMST} class computes a minimum spanning forest
+	 * with a coordinator process and worker processes that exchange
+	 * messages through a <code>Transport</code>.
+	 *
+	 * The vertices are split into one contiguous range per worker, and a
+	 * worker only ever holds the edges from its own range: it receives
+	 * them from the coordinator, or reads them from the graph's file
+	 * itself, and numbers the vertices they touch locally. Each worker
+	 * computes the minimum spanning forest of the edges inside its
+	 * range with <code>MST</code>. Every other edge inside the range is
+	 * on a cycle of lighter edges and is dropped. The remaining candidates
+	 * are the local forest plus the edges leaving the range, and they are
+	 * merged in Boruvka rounds:
+	 *
+	 *		1) every worker proposes, for each component its edges touch,
+	 *		   the lightest of its edges leaving that component
+	 *		2) the coordinator keeps the lightest proposal per component
+	 *		   and adds those edges to the forest
+	 *		3) the coordinator sends each worker the new components of the
+	 *		   vertices it holds, and the workers drop edges that no longer
+	 *		   leave a component
+	 *
+	 * The coordinator keeps O(V) state; the workers keep state in the size
+	 * of their edges. Each round at least halves the number of components
+	 * with an outgoing edge, so there are at most log2(V) rounds.
+	 *
+	 * fork() copies only the calling thread into a worker. If the
+	 * coordinator has started <code>ThreadPool::shared()</code>, a worker's
+	 * copy of the pool has no threads, and a lock one of them held at the
+	 * time of the fork stays held in the worker; the workers do not use the
+	 * pool, so build a <code>PartitionedMST</code> while the pool is idle.
+	 *
+	 * The edges of the graph are taken as undirected, and ties are broken
+	 * by end-points. The result has the weight of a single-process
+	 * <code>MST::cost()</code> only when the graph stores every edge in
+	 * both directions with the same weight; <code>MST</code> follows
+	 * edges only from x to y, so on any other graph the two can differ.
+	 *
+	 * @programmer Richard Caaya
+	 */
+	class PartitionedMST
+	{
+	public:
+
+		/**
+		 * Forks transport.size() - 1 worker processes and computes the
+		 * minimum spanning forest of graph with them. The calling process
+		 * is the coordinator and sends each worker the edges of its range.
+		 * The weight equals <code>MST(graph).cost()</code> only if every
+		 * edge of graph is stored in both directions.
+		 *
+		 * @param graph the edge-weighted graph
+		 * @param transport a transport that no process has attached to yet
+		 * @throws <code>std::invalid_argument</code> if transport has no worker ranks
+		 * @throws <code>std::runtime_error</code> if a worker cannot be
+		 *         started, fails, or a link breaks
+		 */
+		PartitionedMST(const Graph& graph, Transport& transport);
+
+		/**
+		 * Computes the minimum spanning forest of the graph in a file
+		 * without loading it in any one process: every worker reads the
+		 * file and keeps only the edges from its own range. The weight
+		 * equals <code>MST(Graph(filename)).cost()</code> only if the file
+		 * lists every edge in both directions.
+		 *
+		 * @param filename The file name of the input data: V, then integer triples (i, j, cost)
+		 * @param transport a transport that no process has attached to yet
+		 * @throws <code>std::invalid_argument</code> if transport has no worker ranks
+		 * @throws <code>std::runtime_error</code> if a worker cannot be
+		 *         started, fails, or a link breaks
+		 */
+		PartitionedMST(const std::string& filename, Transport& transport);
+
+		/**
+		 * Destructor
+		 */
+		~PartitionedMST();
+
+		/**
+		 * Returns the edges in a minimum spanning forest
+		 * @return the edges in a minimum spanning forest as a vector of edges
+		 */
+		const std::vector<Edge<int>*> edges() const;
+
+		/**
+		 * Returns the sum of the edge weights in a minimum spanning forest.
+		 * @return the total cost
+		 */
+		double cost() const;
+
+		/**
+		 * Returns the number of Boruvka rounds the merge took.
+		 * @return the number of rounds
+		 */
+		int rounds() const { return this->roundCount; }
+
+	private:
+		std::vector<Edge<int>*> tree;
+		int roundCount;
+
+		/**
+		 * Forks the workers over V vertices and runs the coordinator. The
+		 * workers read filename, or receive their edges from graph if it
+		 * is not NULL.
+		 */
+		void run(int V, Transport& transport, const Graph* graph, const std::string& filename);
+
+		PartitionedMST(const PartitionedMST&);
+		PartitionedMST& operator=(const PartitionedMST&);
+	};
+}
+
+#endif /* PARTITIONEDMST_H_ */
@@ -0,0 +1,316 @@
+/**
+ * PipelinedMST.cpp
+ *
+ *  Programmer: Richard Caaya
+ */
+
+#include "PipelinedMST.h"
+#include "BoundedQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace Algorithms
+{
+	typedef PipelinedMST::WeightedEdge WeightedEdge;
+	typedef std::vector<WeightedEdge> Batch;
+
+	static bool lighter(const WeightedEdge& a, const WeightedEdge& b) {
+		if (a.weight != b.weight)
+			return a.weight < b.weight;
+		if (a.x != b.x)
+			return a.x < b.x;
+		return a.y < b.y;
+	}
+
+	static const char* skipSpace(const char* p, const char* end) {
+		while (p < end && std::isspace((unsigned char) *p))
+			++p;
+		return p;
+	}
+
+	static const char* skipToken(const char* p, const char* end) {
+		while (p < end && !std::isspace((unsigned char) *p))
+			++p;
+		return p;
+	}
+
+	/**
+	 * Union-find over the vertices that resets in time proportional to the
+	 * vertices it touched, so a batch much smaller than V stays cheap.
+	 */
+	class IncrementalUnionFind {
+	public:
+		IncrementalUnionFind(int V) : parent(V, -1) {}
+
+		bool unite(int x, int y) {
+			x = find(x);
+			y = find(y);
+			if (x == y)
+				return false;
+			if (parent[x] > parent[y])
+				std::swap(x, y);			// x is the larger tree
+			touch(x);
+			touch(y);
+			parent[x] += parent[y];
+			parent[y] = x;
+			return true;
+		}
+
+		void reset() {
+			for (int v : touched)
+				parent[v] = -1;
+			touched.clear();
+		}
+
+	private:
+		std::vector<int> parent;			// parent[v] < 0: v is a root of -parent[v] vertices
+		std::vector<int> touched;
+
+		int find(int v) {
+			int root = v;
+			while (parent[root] >= 0)
+				root = parent[root];
+			while (parent[v] >= 0 && parent[v] != root) {
+				int next = parent[v];
+				parent[v] = root;
+				v = next;
+			}
+			return root;
+		}
+
+		void touch(int v) {
+			if (parent[v] == -1)
+				touched.push_back(v);		// first change since the last reset
+		}
+	};
+
+	static const size_t READ_CHUNK = 1 << 22;	// bytes read at a time
+
+	/**
+	 * What a slice tells the next one once it has counted its tokens
+	 */
+	struct SliceInfo {
+		std::atomic<long long> prefix;	// edge tokens up to the end of the slice, -1 until known
+		std::string tail[2];			// the prefix % 3 tokens of the triple still open at the end
+	};
+
+	/**
+	 * A run of whole tokens from the file, in order
+	 */
+	struct Slice {
+		std::vector<char> text;						// NUL-terminated
+		std::shared_ptr<SliceInfo> info;
+		std::shared_ptr<const SliceInfo> previous;
+	};
+
+	PipelinedMST::PipelinedMST(const std::string& filename, unsigned int parsers, size_t batchSize) : V(0) {
+
+		std::ifstream inFile(filename.c_str(), std::ios::binary);
+		if(!inFile.is_open()) {
+			std::cout << "File: " << filename << " not found! Aborting!" << std::endl;
+			exit(0);
+		}
+		inFile >> this->V;
+		if (!inFile || this->V < 0) {
+			std::cout << "File: " << filename << " has no valid vertex count! Aborting!" << std::endl;
+			exit(0);
+		}
+
+		if (parsers == 0)
+			parsers = std::max(2u, std::thread::hardware_concurrency()) - 1;
+		batchSize = std::max<size_t>(batchSize, 1);
+
+		BoundedQueue<Slice*> slices(2 * parsers);
+		BoundedQueue<Batch*> queue(4 * parsers);
+		std::atomic<unsigned int> running(parsers);
+		const int vertices = this->V;
+
+		// read the file in chunks cut at whitespace, so no token straddles two slices
+		auto read = [&]() {
+			std::shared_ptr<SliceInfo> previous(new SliceInfo());
+			previous->prefix.store(0);
+			std::string carry;			// the unfinished token at the end of the last chunk
+
+			for (bool last = false; !last; ) {
+				Slice* slice = new Slice();
+				slice->text.assign(carry.begin(), carry.end());
+				slice->text.resize(carry.size() + READ_CHUNK);
+				inFile.read(&slice->text[carry.size()], READ_CHUNK);
+				size_t size = carry.size() + inFile.gcount();
+				last = !inFile;
+
+				size_t cut = size;
+				if (!last)
+					while (cut > 0 && !std::isspace((unsigned char) slice->text[cut - 1]))
+						--cut;
+				carry.assign(slice->text.begin() + cut, slice->text.begin() + size);
+				slice->text.resize(cut);
+				slice->text.push_back('\0');	// lets strtol/strtod stop at the end
+
+				slice->info.reset(new SliceInfo());
+				slice->info->prefix.store(-1);
+				slice->previous = previous;
+				previous = slice->info;
+				slices.push(slice);
+			}
+			for (unsigned int i = 0; i < parsers; ++i)
+				slices.push(NULL);
+		};
+
+		auto parse = [&]() {
+			Batch* batch = new Batch();
+			batch->reserve(batchSize);
+			auto flush = [&]() {
+				std::sort(batch->begin(), batch->end(), lighter);
+				queue.push(batch);
+				batch = new Batch();
+				batch->reserve(batchSize);
+			};
+
+			for (Slice* slice = slices.pop(); slice != NULL; slice = slices.pop()) {
+				const char* begin = &slice->text[0];
+				const char* end = begin + slice->text.size() - 1;
+
+				long long tokens = 0;
+				const char* last[2] = { NULL, NULL };	// the starts of the last two tokens
+				for (const char* t = skipSpace(begin, end); t < end; t = skipSpace(skipToken(t, end), end)) {
+					last[0] = last[1];
+					last[1] = t;
+					tokens++;
+				}
+
+				long long first;				// edge tokens before this slice
+				while ((first = slice->previous->prefix.load(std::memory_order_acquire)) < 0)
+					std::this_thread::yield();
+
+				// hand the triple left open at the end to the next slice
+				int open = (first + tokens) % 3;
+				int inherited = first % 3;
+				for (int k = 0; k < open; ++k) {
+					long long back = open - k;	// position from the end of the stream so far
+					if (back <= tokens) {
+						const char* t = last[2 - back];
+						slice->info->tail[k].assign(t, skipToken(t, end));
+					}
+					else {
+						slice->info->tail[k] = slice->previous->tail[inherited - (back - tokens)];
+					}
+				}
+				slice->info->prefix.store(first + tokens, std::memory_order_release);
+
+				// the open triple of the previous slice continues here
+				const char* triple[3];
+				int k = 0;
+				for (; k < inherited; ++k)
+					triple[k] = slice->previous->tail[k].c_str();
+
+				for (const char* t = skipSpace(begin, end); t < end; t = skipSpace(skipToken(t, end), end)) {
+					triple[k++] = t;
+					if (k < 3)
+						continue;
+					k = 0;
+
+					WeightedEdge e;
+					e.x = std::strtol(triple[0], NULL, 10);
+					e.y = std::strtol(triple[1], NULL, 10);
+					e.weight = std::strtod(triple[2], NULL);
+					if (e.x < 0 || e.x >= vertices || e.y < 0 || e.y >= vertices || e.x == e.y)
+						continue;
+
+					batch->push_back(e);
+					if (batch->size() == batchSize)
+						flush();
+				}
+				delete slice;
+			}
+
+			flush();
+			delete batch;
+			if (running.fetch_sub(1) == 1)
+				queue.push(NULL);			// the last parser out ends the stream
+		};
+
+		// solve while the parsers run: keep the MSF of (forest so far + the sorted batches since)
+		std::vector<WeightedEdge> forest, pending, candidates;
+		std::vector<size_t> runs;			// pending[runs[k], runs[k + 1]) is one sorted batch
+		IncrementalUnionFind uf(this->V);	// before the threads, so a failed allocation cannot leave them joinable
+
+		std::vector<std::thread> pool;
+		pool.push_back(std::thread(read));
+		for (unsigned int i = 0; i < parsers; ++i)
+			pool.push_back(std::thread(parse));
+
+		auto solve = [&]() {
+			runs.push_back(pending.size());
+			while (runs.size() > 2) {
+				std::vector<size_t> merged;
+				size_t k = 0;
+				for (; k + 2 < runs.size(); k += 2) {
+					std::inplace_merge(pending.begin() + runs[k], pending.begin() + runs[k + 1],
+							pending.begin() + runs[k + 2], lighter);
+					merged.push_back(runs[k]);
+				}
+				if (k + 1 < runs.size())
+					merged.push_back(runs[k]);
+				merged.push_back(pending.size());
+				runs.swap(merged);
+			}
+
+			candidates.clear();
+			std::merge(forest.begin(), forest.end(), pending.begin(), pending.end(),
+					std::back_inserter(candidates), lighter);
+			forest.clear();
+			for (const WeightedEdge& e : candidates)
+				if (uf.unite(e.x, e.y))
+					forest.push_back(e);
+			uf.reset();
+
+			pending.clear();
+			runs.clear();
+		};
+
+		for (Batch* batch = queue.pop(); batch != NULL; batch = queue.pop()) {
+			runs.push_back(pending.size());
+			pending.insert(pending.end(), batch->begin(), batch->end());
+			delete batch;
+
+			// a round costs O(forest + pending), so waiting for at least a forest's worth keeps the total O(E)
+			if (pending.size() >= std::max(forest.size(), batchSize))
+				solve();
+		}
+		if (!pending.empty())
+			solve();
+
+		for (std::thread& t : pool)
+			t.join();
+
+		tree.reserve(forest.size());
+		for (const WeightedEdge& e : forest)
+			tree.push_back(new Edge<int>(new Node<int>(e.x), new Node<int>(e.y), e.weight));
+	}
+
+	PipelinedMST::~PipelinedMST() {
+		for (Edge<int>* e : tree)
+			delete e;
+	}
+
+	const std::vector<Edge<int>*> PipelinedMST::edges() const {
+		return tree;
+	}
+
+	double PipelinedMST::cost() const {
+		double weight = 0.0;
+		for (Edge<int>* e : tree)
+			weight += e->getWeight();
+		return weight;
+	}
+}
@@ -0,0 +1,86 @@
+#ifndef PIPELINEDMST_H_
+#define PIPELINEDMST_H_
+
+#include <string>
+#include <vector>
+
+#include "Edge.h"
+
+namespace Algorithms
+{
+	/**
+	 * The {@code PipelinedMST} class computes a minimum spanning forest
+	 * straight from a file in the format read by <code>Graph(filename)</code>,
+	 * overlapping parsing with the solve instead of building a
+	 * <code>Graph</code> first.
+	 *
+	 * A reader thread reads the file in chunks cut at whitespace, and
+	 * parser threads take the chunks as they arrive, so the file is never
+	 * held whole. Parsers sort batches of edges and push them through a
+	 * lock-free <code>BoundedQueue</code>. The solving thread collects
+	 * batches until they hold at least as many edges as the forest so far,
+	 * then runs Kruskal's algorithm over them merged with the forest. An
+	 * edge that this drops closes a cycle of lighter edges and so can never
+	 * be in the final forest; the forest therefore never holds more than
+	 * V - 1 edges, each round costs no more than twice its new edges, and
+	 * the last round leaves the answer. End-to-end time approaches
+	 * max(load, solve).
+	 *
+	 * The edges in the file are taken as undirected: x y w and y x w are the
+	 * same edge, and a repeated edge counts with its lightest weight. Edges
+	 * whose end-points are not in [0, V) are ignored.
+	 *
+	 * @programmer Richard Caaya
+	 */
+	class PipelinedMST
+	{
+	public:
+
+		/**
+		 * Loads filename and computes its minimum spanning forest.
+		 *
+		 * @param filename The file name of the input data: V, then integer triples (i, j, cost)
+		 * @param parsers the number of parser threads (0 = hardware concurrency - 1)
+		 * @param batchSize the number of edges per batch, and the fewest a round of the solve takes
+		 */
+		PipelinedMST(const std::string& filename, unsigned int parsers = 0, size_t batchSize = 1 << 16);
+
+		/**
+		 * Destructor
+		 */
+		~PipelinedMST();
+
+		/**
+		 * Returns the number of vertices read from the file.
+		 * @return the number of vertices
+		 */
+		inline int getV() const { return this->V; }
+
+		/**
+		 * Returns the edges in a minimum spanning forest
+		 * @return the edges in a minimum spanning forest as a vector of edges
+		 */
+		const std::vector<Edge<int>*> edges() const;
+
+		/**
+		 * Returns the sum of the edge weights in a minimum spanning forest.
+		 * @return the total cost
+		 */
+		double cost() const;
+
+		struct WeightedEdge {
+			int x;
+			int y;
+			double weight;
+		};
+
+	private:
+		int V;
+		std::vector<Edge<int>*> tree;
+
+		PipelinedMST(const PipelinedMST&);
+		PipelinedMST& operator=(const PipelinedMST&);
+	};
+}
+
+#endif /* PIPELINEDMST_H_ */
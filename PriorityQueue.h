@@ -29,6 +29,11 @@ namespace Algorithms
 	{
 	public:
 
+		struct HeapEntry {
+			T value;
+			double priority;
+		};
+
 		/**
 		 * Initializes a new empty priority queue
 		 */
@@ -46,8 +51,8 @@ namespace Algorithms
 		void push(T element, double priority) {
 			// double size of array if necessary
 			int length = heap.size();
-			if (currentSize == length - 1)
-				heap.resize(2 * length);
+			if (currentSize >= length - 1)
+				heap.resize(std::max(2, 2 * length));
 
 			// add element, and percolate it up to maintain heap invariant
 			int hole = ++currentSize;
@@ -120,11 +125,23 @@ namespace Algorithms
 			return currentSize;
 		}
 
+		/**
+		 * Exchanges the storage of this queue with storage and empties the
+		 * queue, so that one buffer can serve queue after queue.
+		 *
+		 * @param storage the buffer to use from now on; receives the old one
+		 */
+		void swapStorage(std::vector<HeapEntry>& storage) {
+			heap.swap(storage);
+			currentSize = 0;
+		}
+
 		/**
 		 * Removes all elements from the priority queue.
 		 */
 		void clear() {
 			heap.clear();
+			currentSize = 0;
 		}
 
 		/**
@@ -179,11 +196,6 @@ namespace Algorithms
 			}
 		}
 
-		struct HeapEntry {
-			T value;
-			double priority;
-		};
-
 		std::vector<HeapEntry> heap;
 		int currentSize;
 	};
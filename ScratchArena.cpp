@@ -0,0 +1,22 @@
+/**
+ * ScratchArena.cpp
+ *
+ *  Programmer: Richard Caaya
+ */
+
+#include "ScratchArena.h"
+
+#include <atomic>
+
+namespace Algorithms
+{
+	ScratchArena& ScratchArena::local() {
+		static thread_local ScratchArena arena;
+		return arena;
+	}
+
+	size_t ScratchArena::nextTypeIndex() {
+		static std::atomic<size_t> next(0);
+		return next.fetch_add(1);
+	}
+}
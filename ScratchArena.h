@@ -0,0 +1,164 @@
+/**
+ * ScratchArena.h
+ *
+ *  Programmer Richard Caaya
+ *
+ */
+
+#ifndef SCRATCHARENA_H_
+#define SCRATCHARENA_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace Algorithms
+{
+	/**
+	 * The most free buffers of one type an arena keeps.
+	 */
+	const size_t SCRATCH_BUFFERS_PER_TYPE = 8;
+
+	/**
+	 *	This class keeps the buffers of finished jobs so the next job on the
+	 *	same thread can reuse their memory. A job takes a vector with
+	 *	<code>acquire</code> and hands it back with <code>release</code>; once
+	 *	the buffers have grown to the largest job seen, running another job
+	 *	of that size allocates nothing.
+	 *
+	 *	Every thread, and so every <code>ThreadPool</code> worker, has its own
+	 *	arena, returned by <code>local()</code>. An arena is never shared, so
+	 *	it takes no locks.
+	 *
+	 *	A buffer goes back to the arena of the thread that releases it, which
+	 *	need not be the one that acquired it: an <code>MST</code> returned
+	 *	through a <code>ThreadPool</code> future is destroyed by the caller.
+	 *	So that such a thread does not pile up buffers it never reuses, an
+	 *	arena keeps at most SCRATCH_BUFFERS_PER_TYPE free buffers of each
+	 *	type, the largest ones, and frees the rest.
+	 *
+	 *	@programmer Richard Caaya
+	 */
+	class ScratchArena
+	{
+	public:
+
+		ScratchArena() {}
+
+		~ScratchArena() {
+			clear();
+		}
+
+		/**
+		 * Returns the calling thread's arena
+		 * @return the arena of this thread
+		 */
+		static ScratchArena& local();
+
+		/**
+		 * Returns a vector of n copies of value, reusing a released buffer of
+		 * the same type if there is one.
+		 *
+		 * @param n the size of the vector
+		 * @param value the initial value of every element
+		 * @return the vector, to be handed back with <code>release</code>
+		 */
+		template <typename T>
+		std::vector<T> acquire(size_t n, const T& value = T()) {
+			std::vector<std::vector<T> >& free = buffers<T>();
+			std::vector<T> buffer;
+			if (!free.empty()) {
+				buffer.swap(free.back());
+				free.pop_back();
+			}
+			buffer.assign(n, value);
+			return buffer;
+		}
+
+		/**
+		 * Takes buffer's memory back for a later <code>acquire</code> and
+		 * leaves buffer empty. If the arena already holds
+		 * SCRATCH_BUFFERS_PER_TYPE buffers of this type, the smallest of
+		 * them and buffer is freed instead.
+		 *
+		 * @param buffer a vector, usually from <code>acquire</code>
+		 */
+		template <typename T>
+		void release(std::vector<T>& buffer) {
+			if (buffer.capacity() == 0)
+				return;
+			std::vector<std::vector<T> >& free = buffers<T>();
+			if (free.size() < SCRATCH_BUFFERS_PER_TYPE) {
+				free.push_back(std::vector<T>());
+				free.back().swap(buffer);
+				return;
+			}
+
+			size_t smallest = 0;
+			for (size_t i = 1; i < free.size(); ++i)
+				if (free[i].capacity() < free[smallest].capacity())
+					smallest = i;
+			if (free[smallest].capacity() < buffer.capacity())
+				free[smallest].swap(buffer);
+			std::vector<T>().swap(buffer);
+		}
+
+		/**
+		 * Returns the number of free buffers this arena holds.
+		 * @return the number of buffers, of all types
+		 */
+		size_t size() const {
+			size_t count = 0;
+			for (PoolBase* pool : pools)
+				if (pool != NULL)
+					count += pool->size();
+			return count;
+		}
+
+		/**
+		 * Frees every buffer held by this arena.
+		 */
+		void clear() {
+			for (PoolBase* pool : pools)
+				delete pool;
+			pools.clear();
+		}
+
+	private:
+		struct PoolBase {
+			virtual ~PoolBase() {}
+			virtual size_t size() const = 0;
+		};
+
+		template <typename T>
+		struct Pool : PoolBase {
+			std::vector<std::vector<T> > free;
+
+			size_t size() const { return free.size(); }
+		};
+
+		std::vector<PoolBase*> pools;		// pools[typeIndex<T>()] holds the free vectors of T, or NULL
+
+		static size_t nextTypeIndex();
+
+		template <typename T>
+		static size_t typeIndex() {
+			static const size_t index = nextTypeIndex();
+			return index;
+		}
+
+		template <typename T>
+		std::vector<std::vector<T> >& buffers() {
+			size_t index = typeIndex<T>();
+			if (index >= pools.size())
+				pools.resize(index + 1, NULL);
+			if (pools[index] == NULL)
+				pools[index] = new Pool<T>();
+			return static_cast<Pool<T>*>(pools[index])->free;
+		}
+
+		ScratchArena(const ScratchArena&);
+		ScratchArena& operator=(const ScratchArena&);
+	};
+}
+
+#endif /* SCRATCHARENA_H_ */
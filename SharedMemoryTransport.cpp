@@ -0,0 +1,177 @@
+/**
+ * SharedMemoryTransport.cpp
+ *
+ *  Programmer: Richard Caaya
+ */
+
+#include "SharedMemoryTransport.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <cerrno>
+#include <ctime>
+#include <stdint.h>
+
+#include <sys/mman.h>
+
+namespace Algorithms
+{
+	/**
+	 * Unlocks a channel's mutex when it goes out of scope
+	 */
+	class ChannelGuard {
+	public:
+		explicit ChannelGuard(pthread_mutex_t& mutex) : mutex(mutex) {}
+		~ChannelGuard() { pthread_mutex_unlock(&mutex); }
+
+	private:
+		pthread_mutex_t& mutex;
+	};
+
+	SharedMemoryTransport::SharedMemoryTransport(int workers) :
+			workers(workers),
+			rank(-1),
+			channels(NULL) {
+
+		assert(workers >= 1);
+
+		void* region = mmap(NULL, 2 * workers * sizeof(Channel), PROT_READ | PROT_WRITE,
+				MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+		if (region == MAP_FAILED)
+			throw std::runtime_error("Cannot map the shared memory region");
+		channels = static_cast<Channel*>(region);
+
+		pthread_mutexattr_t mutexAttributes;
+		pthread_mutexattr_init(&mutexAttributes);
+		pthread_mutexattr_setpshared(&mutexAttributes, PTHREAD_PROCESS_SHARED);
+		pthread_mutexattr_setrobust(&mutexAttributes, PTHREAD_MUTEX_ROBUST);
+		pthread_condattr_t condAttributes;
+		pthread_condattr_init(&condAttributes);
+		pthread_condattr_setpshared(&condAttributes, PTHREAD_PROCESS_SHARED);
+		pthread_condattr_setclock(&condAttributes, CLOCK_MONOTONIC);
+
+		for (int i = 0; i < 2 * workers; ++i) {
+			pthread_mutex_init(&channels[i].mutex, &mutexAttributes);
+			pthread_cond_init(&channels[i].notEmpty, &condAttributes);
+			pthread_cond_init(&channels[i].notFull, &condAttributes);
+			channels[i].broken = false;
+			channels[i].head = 0;
+			channels[i].tail = 0;
+		}
+
+		pthread_mutexattr_destroy(&mutexAttributes);
+		pthread_condattr_destroy(&condAttributes);
+	}
+
+	SharedMemoryTransport::~SharedMemoryTransport() {
+		// the synchronization objects go with the region: a worker killed
+		// while waiting is still counted as a waiter, and destroying its
+		// condition variable would block forever
+		munmap(channels, 2 * workers * sizeof(Channel));
+	}
+
+	void SharedMemoryTransport::attach(int rank) {
+		assert(rank >= 0 && rank <= workers);
+		this->rank = rank;
+	}
+
+	SharedMemoryTransport::Channel& SharedMemoryTransport::outgoing(int to) {
+		assert((rank == 0) != (to == 0));
+		return (rank == 0) ? channels[2 * (to - 1)] : channels[2 * (rank - 1) + 1];
+	}
+
+	SharedMemoryTransport::Channel& SharedMemoryTransport::incoming(int from) {
+		assert((rank == 0) != (from == 0));
+		return (rank == 0) ? channels[2 * (from - 1) + 1] : channels[2 * (rank - 1)];
+	}
+
+	void SharedMemoryTransport::send(int to, const std::vector<char>& message) {
+		Channel& channel = outgoing(to);
+		uint64_t length = message.size();
+
+		lock(channel);
+		ChannelGuard guard(channel.mutex);
+		write(channel, to, reinterpret_cast<const char*>(&length), sizeof(length));
+		write(channel, to, message.empty() ? NULL : &message[0], message.size());
+	}
+
+	std::vector<char> SharedMemoryTransport::receive(int from) {
+		Channel& channel = incoming(from);
+		uint64_t length = 0;
+
+		lock(channel);
+		ChannelGuard guard(channel.mutex);
+		read(channel, from, reinterpret_cast<char*>(&length), sizeof(length));
+		std::vector<char> message(length);
+		read(channel, from, message.empty() ? NULL : &message[0], message.size());
+		return message;
+	}
+
+	void SharedMemoryTransport::lock(Channel& channel) {
+		int error = pthread_mutex_lock(&channel.mutex);
+		if (error == EOWNERDEAD) {
+			// the owner died half way through a message
+			channel.broken = true;
+			pthread_mutex_consistent(&channel.mutex);
+		}
+		else if (error != 0) {
+			throw std::runtime_error("Cannot lock a shared memory channel");
+		}
+		if (channel.broken) {
+			pthread_mutex_unlock(&channel.mutex);
+			throw std::runtime_error("Peer process died");
+		}
+	}
+
+	void SharedMemoryTransport::wait(Channel& channel, pthread_cond_t& condition, int peer) const {
+		timespec deadline;
+		clock_gettime(CLOCK_MONOTONIC, &deadline);
+		deadline.tv_nsec += SHARED_POLL_MILLISECONDS * 1000000L;
+		deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+		deadline.tv_nsec %= 1000000000L;
+
+		int error = pthread_cond_timedwait(&condition, &channel.mutex, &deadline);
+		if (error == EOWNERDEAD) {
+			channel.broken = true;
+			pthread_mutex_consistent(&channel.mutex);
+		}
+		else if (error == ETIMEDOUT && !isRunning(peer)) {
+			channel.broken = true;
+		}
+		if (channel.broken)
+			throw std::runtime_error("Peer process died");
+	}
+
+	void SharedMemoryTransport::write(Channel& channel, int peer, const char* data, size_t n) const {
+		while (n > 0) {
+			while (channel.tail - channel.head == SHARED_CHANNEL_CAPACITY)
+				wait(channel, channel.notFull, peer);
+
+			size_t offset = channel.tail % SHARED_CHANNEL_CAPACITY;
+			size_t room = SHARED_CHANNEL_CAPACITY - (channel.tail - channel.head);
+			size_t k = std::min(n, std::min(room, SHARED_CHANNEL_CAPACITY - offset));
+			memcpy(channel.buffer + offset, data, k);
+			channel.tail += k;
+			data += k;
+			n -= k;
+			pthread_cond_signal(&channel.notEmpty);
+		}
+	}
+
+	void SharedMemoryTransport::read(Channel& channel, int peer, char* data, size_t n) const {
+		while (n > 0) {
+			while (channel.tail == channel.head)
+				wait(channel, channel.notEmpty, peer);
+
+			size_t offset = channel.head % SHARED_CHANNEL_CAPACITY;
+			size_t k = std::min(n, std::min(channel.tail - channel.head, SHARED_CHANNEL_CAPACITY - offset));
+			memcpy(data, channel.buffer + offset, k);
+			channel.head += k;
+			data += k;
+			n -= k;
+			pthread_cond_signal(&channel.notFull);
+		}
+	}
+}
@@ -0,0 +1,83 @@
+#ifndef SHAREDMEMORYTRANSPORT_H_
+#define SHAREDMEMORYTRANSPORT_H_
+
+#include <cstddef>
+#include <pthread.h>
+
+#include "Transport.h"
+
+namespace Algorithms
+{
+	/**
+	 * Bytes buffered in each direction of a coordinator-worker link.
+	 */
+	const size_t SHARED_CHANNEL_CAPACITY = 1 << 20;
+
+	/**
+	 * How often a blocked process checks that its peer is alive.
+	 */
+	const int SHARED_POLL_MILLISECONDS = 100;
+
+	/**
+	 * A <code>Transport</code> over a shared memory region that the workers
+	 * inherit across fork(). Each coordinator-worker link is a pair of
+	 * byte rings guarded by a process-shared mutex and condition variables.
+	 * Messages larger than a ring stream through it.
+	 *
+	 * A process blocked on a link wakes up every SHARED_POLL_MILLISECONDS
+	 * to check that the process at the other end is still alive, by the
+	 * pid the coordinator recorded when it forked the worker, and the
+	 * mutexes are robust, so a peer that dies, even while holding one,
+	 * makes <code>send</code> and <code>receive</code> throw instead of
+	 * hanging. The link is then marked broken for both ends.
+	 *
+	 * @programmer Richard Caaya
+	 */
+	class SharedMemoryTransport : public Transport
+	{
+	public:
+
+		/**
+		 * Maps the shared region for a coordinator and the given number of workers.
+		 *
+		 * @param workers the number of worker processes
+		 * @throws <code>std::runtime_error</code> if the region cannot be mapped
+		 */
+		SharedMemoryTransport(int workers);
+
+		~SharedMemoryTransport();
+
+		void attach(int rank);
+		int size() const { return this->workers + 1; }
+		void send(int to, const std::vector<char>& message);
+		std::vector<char> receive(int from);
+
+	private:
+		struct Channel {
+			pthread_mutex_t mutex;
+			pthread_cond_t notEmpty;
+			pthread_cond_t notFull;
+			bool broken;			// an end died while using the channel
+			size_t head;			// bytes read so far
+			size_t tail;			// bytes written so far
+			char buffer[SHARED_CHANNEL_CAPACITY];
+		};
+
+		int workers;
+		int rank;
+		Channel* channels;			// 2 per worker: coordinator to worker, then worker to coordinator
+
+		Channel& outgoing(int to);
+		Channel& incoming(int from);
+
+		static void lock(Channel& channel);
+		void wait(Channel& channel, pthread_cond_t& condition, int peer) const;
+		void write(Channel& channel, int peer, const char* data, size_t n) const;
+		void read(Channel& channel, int peer, char* data, size_t n) const;
+
+		SharedMemoryTransport(const SharedMemoryTransport&);
+		SharedMemoryTransport& operator=(const SharedMemoryTransport&);
+	};
+}
+
+#endif /* SHAREDMEMORYTRANSPORT_H_ */
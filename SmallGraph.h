@@ -0,0 +1,234 @@
+/**
+ * SmallGraph.h
+ *
+ *  Programmer Richard Caaya
+ *
+ */
+
+#ifndef SMALLGRAPH_H_
+#define SMALLGRAPH_H_
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "Graph.h"
+
+namespace Algorithms
+{
+	/**
+	 *	This class implements a graph of at most N vertices, N <= 64, that
+	 *	lives entirely in fixed-size arrays: one 64-bit adjacency mask per
+	 *	row and an N x N weight matrix. It never allocates, so it can sit on
+	 *	the stack or be packed by the million into one vector. A copy moves
+	 *	only the first V rows and columns of the weights.
+	 *
+	 *	It is the small-graph counterpart of <code>Graph</code>, with the
+	 *	same edge semantics: an edge x-y is stored in row x only, so an
+	 *	undirected graph adds both x-y and y-x. <code>SmallMST</code> solves it.
+	 *
+	 *	@programmer Richard Caaya
+	 */
+	template <int N = MAX_GRAPH_SIZE>
+	class SmallGraph
+	{
+		static_assert(N >= 1 && N <= 64, "a SmallGraph row is a single 64-bit word");
+
+	public:
+
+		/**
+		 * Initializes an empty graph with V vertices and 0 edges.
+		 *
+		 * @param V the number of vertices, at most N
+		 */
+		SmallGraph(int V = N) : V(V), E(0) {
+			assert(V >= 0 && V <= N);
+			clear();		// weights are only read behind a set bit, so they stay uninitialised
+		}
+
+		/**
+		 * Copies a graph of at most N vertices.
+		 *
+		 * @param graph the graph to copy
+		 * @throws invalid_argument if graph has more than N vertices
+		 */
+		explicit SmallGraph(const Graph& graph) : SmallGraph(checkSize(graph.getV())) {
+			for (int x = 0; x < V; ++x)
+				graph.forEachNeighbor(x, [&](int y, double w) { addEdge(x, y, w); });
+		}
+
+		SmallGraph(const SmallGraph& graph) {
+			copy(graph);
+		}
+
+		SmallGraph& operator=(const SmallGraph& graph) {
+			if (this != &graph)
+				copy(graph);
+			return *this;
+		}
+
+		/**
+		 * Removes every edge, and optionally changes the number of vertices.
+		 *
+		 * @param V the new number of vertices, at most N (-1 keeps the current one)
+		 */
+		void clear(int V = -1) {
+			if (V >= 0) {
+				assert(V <= N);
+				this->V = V;
+			}
+			for (int x = 0; x < N; ++x)
+				adjacency[x] = 0;
+			E = 0;
+		}
+
+		/**
+		 * Returns the number of vertices in this graph.
+		 *
+		 * @return the number of vertices in this graph
+		 */
+		inline int getV() const { return this->V; }
+
+		/**
+		 * Returns the number of edges in this graph.
+		 *
+		 * @return the number of edges in this graph
+		 */
+		inline int getE() const { return this->E; }
+
+		/**
+		 * Tests whether there is an edge from node x to node y
+		 *
+		 * @param x the node x
+		 * @param y the node y
+		 * @return TRUE if there is an edge from node x to node y,
+		 * 		   and FALSE otherwise
+		 */
+		inline bool isAdjacent(int x, int y) const {
+			assert(x >= 0 && x < V && y >= 0 && y < V);
+			return (adjacency[x] >> y) & 1;
+		}
+
+		/**
+		 * Adds the edge x-y to this graph.
+		 *
+		 * @param x one vertex in the edge
+		 * @param y the other vertex in the edge
+		 * @param w the weight
+		 * @return TRUE if it is not there and FALSE otherwise
+		 */
+		bool addEdge(int x, int y, double w = 0.0) {
+			if (isAdjacent(x, y))
+				return false;
+			adjacency[x] |= uint64_t(1) << y;
+			weights[x][y] = w;
+			E++;
+			return true;
+		}
+
+		/**
+		 * Removes the edge x-y from this graph.
+		 * @param x one vertex in the edge
+		 * @param y the other vertex in the edge
+		 * @return TRUE if it is there and FALSE otherwise
+		 */
+		bool removeEdge(int x, int y) {
+			if (!isAdjacent(x, y))
+				return false;
+			adjacency[x] &= ~(uint64_t(1) << y);
+			E--;
+			return true;
+		}
+
+		/**
+		 * Sets the weight of the edge (x,y) to v, if it is there.
+		 * @param x node
+		 * @param y node
+		 * @param v the new weight
+		 */
+		void setEdgeValue(int x, int y, double v) {
+			if (isAdjacent(x, y))
+				weights[x][y] = v;
+		}
+
+		/**
+		 * Returns the weight of the edge (x,y).
+		 * @param x node
+		 * @param y node
+		 * @return the weight, or infinity if there is no edge (x,y)
+		 */
+		inline double getEdgeValue(int x, int y) const {
+			return isAdjacent(x, y) ? weights[x][y] : std::numeric_limits<double>::infinity();
+		}
+
+		/**
+		 * Returns the degree of vertex
+		 * @param v v the vertex
+		 * @return the degree of vertex
+		 */
+		inline int getDegree(int v) const {
+			assert(v >= 0 && v < V);
+			return __builtin_popcountll(adjacency[v]);
+		}
+
+		/**
+		 * Returns row x of the adjacency matrix: bit y is set if there is an edge x-y.
+		 *
+		 * @param x the node x
+		 * @return the adjacency mask of x
+		 */
+		inline uint64_t getRow(int x) const { return adjacency[x]; }
+
+		/**
+		 * Returns row x of the weight matrix: entry y is the weight of the
+		 * edge x-y when bit y of getRow(x) is set, and undefined otherwise.
+		 *
+		 * @param x the node x
+		 * @return a pointer to N weights
+		 */
+		inline const double* getWeightRow(int x) const { return weights[x]; }
+
+		/**
+		 * Calls visit(y, w) for every edge x-y of weight w, in ascending order of y.
+		 *
+		 * @param x the node to enumerate
+		 * @param visit a callable taking (int, double)
+		 */
+		template <typename Visitor>
+		void forEachNeighbor(int x, Visitor visit) const {
+			for (uint64_t bits = adjacency[x]; bits != 0; bits &= bits - 1) {
+				int y = __builtin_ctzll(bits);
+				visit(y, weights[x][y]);
+			}
+		}
+
+	private:
+		int V;
+		int E;
+		uint64_t adjacency[N];			// bit y of adjacency[x] is set if there is an edge x-y
+		double weights[N][N];			// weights[x][y] = weight of x-y, if there is one
+
+		static int checkSize(int V) {
+			if (V > N)
+				throw std::invalid_argument("Too many vertices for a SmallGraph");
+			return V;
+		}
+
+		/**
+		 * Copies the rows of graph; only weights[x][y] with x, y < V can be set
+		 */
+		void copy(const SmallGraph& graph) {
+			V = graph.V;
+			E = graph.E;
+			std::memcpy(adjacency, graph.adjacency, V * sizeof(uint64_t));
+			for (int x = V; x < N; ++x)
+				adjacency[x] = 0;
+			for (int x = 0; x < V; ++x)
+				std::memcpy(weights[x], graph.weights[x], V * sizeof(double));
+		}
+	};
+}
+
+#endif /* SMALLGRAPH_H_ */
@@ -0,0 +1,202 @@
+/**
+ * SmallMST.h
+ *
+ *  Programmer Richard Caaya
+ *
+ */
+
+#ifndef SMALLMST_H_
+#define SMALLMST_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "SmallGraph.h"
+#include "ThreadPool.h"
+
+namespace Algorithms
+{
+	/**
+	 * The {@code SmallMST} class computes a minimum spanning forest of a
+	 * <code>SmallGraph</code> with the array variant of Prim's algorithm,
+	 * entirely in fixed-size arrays. The vertices still outside the tree
+	 * are a 64-bit mask, so the arg-min scan and the relaxation of a new
+	 * tree vertex visit only set bits. A graph is solved in O(N^2) time
+	 * without touching the heap.
+	 *
+	 * <code>solveBatch</code> solves many graphs on the shared
+	 * <code>ThreadPool</code> and allocates nothing per graph. A <code>SmallGraph</code> takes about
+	 * 8 N^2 bytes (20 KB at N = 50), so for millions of graphs the form
+	 * that builds each one on the solving thread's stack is preferable to
+	 * storing them all.
+	 *
+	 * @programmer Richard Caaya
+	 */
+	template <int N = MAX_GRAPH_SIZE>
+	class SmallMST
+	{
+	public:
+
+		/**
+		 * An empty forest, to be filled by <code>solve</code>
+		 */
+		SmallMST() : edgeCount(0), total(0.0) {}
+
+		/**
+		 * Compute a minimum spanning forest of graph.
+		 *
+		 * @param graph the edge-weighted graph
+		 */
+		explicit SmallMST(const SmallGraph<N>& graph) {
+			solve(graph);
+		}
+
+		/**
+		 * Replaces this forest with a minimum spanning forest of graph.
+		 *
+		 * @param graph the edge-weighted graph
+		 */
+		void solve(const SmallGraph<N>& graph) {
+			const int V = graph.getV();
+			double key[N];				// key[v] = weight of the lightest edge from the tree to v
+			int via[N];					// via[v] = the tree end-point of that edge
+			for (int v = 0; v < V; ++v) {
+				key[v] = std::numeric_limits<double>::infinity();
+				via[v] = -1;
+			}
+
+			uint64_t outside = (V == 64) ? ~uint64_t(0) : (uint64_t(1) << V) - 1;
+			edgeCount = 0;
+			total = 0.0;
+			while (outside != 0) {
+				int v = -1;
+				double best = std::numeric_limits<double>::infinity();
+				for (uint64_t bits = outside; bits != 0; bits &= bits - 1) {
+					int u = __builtin_ctzll(bits);
+					if (key[u] < best) {
+						best = key[u];
+						v = u;
+					}
+				}
+				if (v < 0) {
+					v = __builtin_ctzll(outside);	// nothing reachable from the current tree: start the next one
+				}
+				else {
+					from[edgeCount] = via[v];
+					to[edgeCount] = v;
+					weights[edgeCount] = best;
+					edgeCount++;
+					total += best;
+				}
+				outside &= ~(uint64_t(1) << v);
+
+				const double* row = graph.getWeightRow(v);
+				for (uint64_t bits = graph.getRow(v) & outside; bits != 0; bits &= bits - 1) {
+					int y = __builtin_ctzll(bits);
+					if (row[y] < key[y]) {
+						key[y] = row[y];
+						via[y] = v;
+					}
+				}
+			}
+		}
+
+		/**
+		 * Solves count graphs across threads without storing them: each
+		 * thread fills one graph on its stack with build(i, graph), solves
+		 * it, and hands the forest to visit(i, tree). Calls for different
+		 * i may run concurrently.
+		 *
+		 * @param count the number of graphs
+		 * @param build a callable taking (size_t, SmallGraph<N>&) that fills an empty graph
+		 * @param visit a callable taking (size_t, const SmallMST<N>&)
+		 * @param threads the most threads to use (0 = all of <code>ThreadPool::shared()</code>)
+		 */
+		template <typename Builder, typename Visitor>
+		static void solveBatch(size_t count, Builder build, Visitor visit, unsigned int threads = 0) {
+			// one graph and one forest per chunk, on the stack of whichever thread runs it
+			auto worker = [&](size_t begin, size_t end) {
+				SmallGraph<N> graph;
+				SmallMST<N> tree;
+				for (size_t i = begin; i < end; ++i) {
+					graph.clear();
+					build(i, graph);
+					tree.solve(graph);
+					visit(i, tree);
+				}
+			};
+			ThreadPool::shared().parallelFor(0, count, BATCH_GRAIN, worker, threads);
+		}
+
+		/**
+		 * Solves every graph of a batch, split across threads.
+		 *
+		 * @param graphs the graphs to solve
+		 * @param trees receives the minimum spanning forest of graphs[i] at index i
+		 * @param threads the most threads to use (0 = all of <code>ThreadPool::shared()</code>)
+		 */
+		static void solveBatch(const std::vector<SmallGraph<N> >& graphs, std::vector<SmallMST<N> >& trees, unsigned int threads = 0) {
+			trees.resize(graphs.size());
+			ThreadPool::shared().parallelFor(0, graphs.size(), BATCH_GRAIN, [&](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i)
+					trees[i].solve(graphs[i]);
+			}, threads);
+		}
+
+		/**
+		 * Returns the number of edges in the forest.
+		 * @return the number of edges, V minus the number of trees
+		 */
+		inline int size() const { return this->edgeCount; }
+
+		/**
+		 * Returns the tree end-point of edge i, in the order the edges were added.
+		 * @param i the edge, 0 <= i < size()
+		 * @return the end-point already on the tree when edge i was added
+		 */
+		inline int getX(int i) const {
+			assert(i >= 0 && i < edgeCount);
+			return from[i];
+		}
+
+		/**
+		 * Returns the vertex edge i added to the tree.
+		 * @param i the edge, 0 <= i < size()
+		 * @return the end-point edge i brought into the tree
+		 */
+		inline int getY(int i) const {
+			assert(i >= 0 && i < edgeCount);
+			return to[i];
+		}
+
+		/**
+		 * Returns the weight of edge i.
+		 * @param i the edge, 0 <= i < size()
+		 * @return the weight of edge i
+		 */
+		inline double getWeight(int i) const {
+			assert(i >= 0 && i < edgeCount);
+			return weights[i];
+		}
+
+		/**
+		 * Returns the sum of the edge weights in the forest.
+		 * @return the total cost
+		 */
+		inline double cost() const { return this->total; }
+
+	private:
+		static const size_t BATCH_GRAIN = 256;		// graphs a thread takes at a time
+
+		int edgeCount;
+		double total;
+		int from[N];
+		int to[N];
+		double weights[N];
+	};
+}
+
+#endif /* SMALLMST_H_ */
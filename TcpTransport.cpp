@@ -0,0 +1,172 @@
+/**
+ * TcpTransport.cpp
+ *
+ *  Programmer: Richard Caaya
+ */
+
+#include "TcpTransport.h"
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <stdint.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace Algorithms
+{
+	static std::runtime_error socketError(const std::string& what) {
+		return std::runtime_error(what + ": " + strerror(errno));
+	}
+
+	static sockaddr_in loopback(int port) {
+		sockaddr_in address;
+		memset(&address, 0, sizeof(address));
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		address.sin_port = htons(port);
+		return address;
+	}
+
+	static void setNoDelay(int fd) {
+		int one = 1;
+		setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+	}
+
+	TcpTransport::TcpTransport(int workers) :
+			workers(workers),
+			port(0),
+			listener(-1),
+			sockets(workers + 1, -1) {
+
+		assert(workers >= 1);
+
+		listener = socket(AF_INET, SOCK_STREAM, 0);
+		if (listener < 0)
+			throw socketError("socket");
+
+		sockaddr_in address = loopback(0);
+		socklen_t length = sizeof(address);
+		if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0
+				|| listen(listener, workers) < 0
+				|| getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length) < 0) {
+			close(listener);
+			throw socketError("listen");
+		}
+		port = ntohs(address.sin_port);
+	}
+
+	TcpTransport::~TcpTransport() {
+		if (listener >= 0)
+			close(listener);
+		for (int fd : sockets)
+			if (fd >= 0)
+				close(fd);
+	}
+
+	void TcpTransport::attach(int rank) {
+		assert(rank >= 0 && rank <= workers);
+
+		if (rank == 0) {
+			for (int i = 0; i < workers; ++i) {
+				// wait for the next worker, making sure now and then that none has died before connecting
+				pollfd incoming = { listener, POLLIN, 0 };
+				int ready = poll(&incoming, 1, TCP_POLL_MILLISECONDS);
+				if (ready < 0 && errno != EINTR)
+					throw socketError("poll");
+				if (ready <= 0) {
+					for (int r = 1; r <= workers; ++r)
+						if (sockets[r] < 0 && !isRunning(r))
+							throw std::runtime_error("A worker process died before connecting");
+					--i;
+					continue;
+				}
+
+				int fd = accept(listener, NULL, NULL);
+				if (fd < 0) {
+					if (errno == EINTR) {
+						--i;
+						continue;
+					}
+					throw socketError("accept");
+				}
+				int32_t peer = 0;
+				readFully(fd, reinterpret_cast<char*>(&peer), sizeof(peer));
+				if (peer < 1 || peer > workers || sockets[peer] >= 0) {
+					close(fd);
+					throw std::runtime_error("Unexpected worker rank");
+				}
+				setNoDelay(fd);
+				sockets[peer] = fd;
+			}
+		}
+		else {
+			int fd = socket(AF_INET, SOCK_STREAM, 0);
+			if (fd < 0)
+				throw socketError("socket");
+			sockaddr_in address = loopback(port);
+			if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+				close(fd);
+				throw socketError("connect");
+			}
+			setNoDelay(fd);
+			int32_t self = rank;
+			writeFully(fd, reinterpret_cast<const char*>(&self), sizeof(self));
+			sockets[0] = fd;
+		}
+
+		close(listener);
+		listener = -1;
+	}
+
+	void TcpTransport::send(int to, const std::vector<char>& message) {
+		assert(sockets[to] >= 0);
+		uint64_t length = message.size();
+		writeFully(sockets[to], reinterpret_cast<const char*>(&length), sizeof(length));
+		writeFully(sockets[to], message.empty() ? NULL : &message[0], message.size());
+	}
+
+	std::vector<char> TcpTransport::receive(int from) {
+		assert(sockets[from] >= 0);
+		uint64_t length = 0;
+		readFully(sockets[from], reinterpret_cast<char*>(&length), sizeof(length));
+		std::vector<char> message(length);
+		readFully(sockets[from], message.empty() ? NULL : &message[0], message.size());
+		return message;
+	}
+
+	void TcpTransport::writeFully(int fd, const char* data, size_t n) {
+		while (n > 0) {
+			ssize_t k = ::send(fd, data, n, MSG_NOSIGNAL);
+			if (k < 0) {
+				if (errno == EINTR)
+					continue;
+				throw socketError("send");
+			}
+			data += k;
+			n -= k;
+		}
+	}
+
+	void TcpTransport::readFully(int fd, char* data, size_t n) {
+		while (n > 0) {
+			ssize_t k = ::recv(fd, data, n, 0);
+			if (k == 0)
+				throw std::runtime_error("Connection closed by peer");
+			if (k < 0) {
+				if (errno == EINTR)
+					continue;
+				throw socketError("recv");
+			}
+			data += k;
+			n -= k;
+		}
+	}
+}
@@ -0,0 +1,68 @@
+#ifndef TCPTRANSPORT_H_
+#define TCPTRANSPORT_H_
+
+#include <vector>
+#include <cstddef>
+
+#include "Transport.h"
+
+namespace Algorithms
+{
+	/**
+	 * How often a coordinator waiting for workers to connect checks that they are alive.
+	 */
+	const int TCP_POLL_MILLISECONDS = 100;
+
+	/**
+	 * A <code>Transport</code> over TCP connections on the loopback
+	 * interface. The coordinator listens on an ephemeral port chosen when
+	 * the transport is created. Each worker connects to it after the fork
+	 * and introduces itself with its rank. Messages are length-prefixed.
+	 *
+	 * A worker that dies before it connects makes the coordinator's
+	 * <code>attach</code> throw rather than wait for it forever; once
+	 * connected, a dead peer closes its socket and <code>receive</code>
+	 * throws.
+	 *
+	 * @programmer Richard Caaya
+	 */
+	class TcpTransport : public Transport
+	{
+	public:
+
+		/**
+		 * Opens the listening socket for a coordinator and the given number of workers.
+		 *
+		 * @param workers the number of worker processes
+		 * @throws <code>std::runtime_error</code> if the socket cannot be set up
+		 */
+		TcpTransport(int workers);
+
+		~TcpTransport();
+
+		void attach(int rank);
+		int size() const { return this->workers + 1; }
+		void send(int to, const std::vector<char>& message);
+		std::vector<char> receive(int from);
+
+		/**
+		 * Returns the port the coordinator listens on.
+		 * @return the port number
+		 */
+		int getPort() const { return this->port; }
+
+	private:
+		int workers;
+		int port;
+		int listener;					// listening socket, closed once attached
+		std::vector<int> sockets;		// sockets[r] = connection to rank r, -1 if none
+
+		static void writeFully(int fd, const char* data, size_t n);
+		static void readFully(int fd, char* data, size_t n);
+
+		TcpTransport(const TcpTransport&);
+		TcpTransport& operator=(const TcpTransport&);
+	};
+}
+
+#endif /* TCPTRANSPORT_H_ */
@@ -0,0 +1,109 @@
+/**
+ * ThreadPool.cpp
+ *
+ *  Programmer: Richard Caaya
+ */
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace Algorithms
+{
+	static thread_local const ThreadPool* currentPool = NULL;	// the pool the calling thread works for
+	static thread_local int currentWorker = -1;
+
+	ThreadPool::ThreadPool(unsigned int threads) : pending(0), nextQueue(0), stopping(false) {
+		if (threads == 0)
+			threads = std::max(1u, std::thread::hardware_concurrency());
+
+		for (unsigned int i = 0; i < threads; ++i)
+			queues.push_back(new Queue());
+		for (unsigned int i = 0; i < threads; ++i)
+			workers.push_back(std::thread(&ThreadPool::work, this, i));
+	}
+
+	ThreadPool::~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			stopping = true;
+		}
+		wake.notify_all();
+		for (std::thread& t : workers)
+			t.join();
+		for (Queue* queue : queues)
+			delete queue;
+	}
+
+	ThreadPool& ThreadPool::shared() {
+		static ThreadPool pool;
+		return pool;
+	}
+
+	int ThreadPool::self() const {
+		return (currentPool == this) ? currentWorker : -1;
+	}
+
+	void ThreadPool::enqueue(std::function<void()> job) {
+		int i = self();
+		Queue& queue = *queues[i >= 0 ? i : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size()];
+		{
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			queue.jobs.push_back(std::move(job));
+		}
+		pending.fetch_add(1);
+
+		// a worker that saw no jobs is either still holding sleepMutex or already waiting
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+		}
+		wake.notify_one();
+	}
+
+	bool ThreadPool::runOne() {
+		if (pending.load() == 0)
+			return false;
+
+		const int home = self();
+		const unsigned int n = size();
+		std::function<void()> job;
+
+		// own queue from the back, then the others from the front
+		for (unsigned int k = 0; k < n && !job; ++k) {
+			bool own = (home >= 0 && k == 0);
+			Queue& queue = *queues[home >= 0 ? (home + k) % n : k];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			if (queue.jobs.empty())
+				continue;
+			if (own) {
+				job = std::move(queue.jobs.back());
+				queue.jobs.pop_back();
+			}
+			else {
+				job = std::move(queue.jobs.front());
+				queue.jobs.pop_front();
+			}
+		}
+		if (!job)
+			return false;
+
+		pending.fetch_sub(1);
+		job();
+		return true;
+	}
+
+	void ThreadPool::work(unsigned int index) {
+		currentPool = this;
+		currentWorker = index;
+
+		for (;;) {
+			if (runOne())
+				continue;
+
+			std::unique_lock<std::mutex> lock(sleepMutex);
+			wake.wait(lock, [this]() { return stopping || pending.load() > 0; });
+			if (stopping && pending.load() == 0)
+				return;
+		}
+	}
+}
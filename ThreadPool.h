@@ -0,0 +1,181 @@
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ScratchArena.h"
+
+namespace Algorithms
+{
+	/**
+	 * The {@code ThreadPool} class runs jobs on a fixed set of worker
+	 * threads with work stealing. Each worker has its own double-ended
+	 * queue. A job submitted from a worker goes to the back of that
+	 * worker's queue, and one submitted from outside goes to the workers in
+	 * turn. A worker takes jobs from the back of its own queue and, when
+	 * that is empty, steals from the front of the others, so nested work
+	 * stays on the thread whose cache holds it while idle workers balance
+	 * the load.
+	 *
+	 * <code>submit</code> returns a future for a single job.
+	 * <code>parallelFor</code> splits a range into chunks that the caller
+	 * and the workers take as they become free. The caller runs queued
+	 * jobs while it waits, so it may be called from inside a job.
+	 *
+	 * Every worker has its own <code>ScratchArena</code>, where jobs such as
+	 * <code>MST</code> recycle their buffers. <code>shared()</code> is the
+	 * pool used by the parallel code in this library.
+	 *
+	 * @programmer Richard Caaya
+	 */
+	class ThreadPool
+	{
+	public:
+
+		/**
+		 * Starts the workers.
+		 *
+		 * @param threads the number of workers (0 = hardware concurrency)
+		 */
+		ThreadPool(unsigned int threads = 0);
+
+		/**
+		 * Runs the jobs still queued, then stops the workers.
+		 */
+		~ThreadPool();
+
+		/**
+		 * Returns the pool shared by the library, with one worker per hardware thread.
+		 * @return the shared pool
+		 */
+		static ThreadPool& shared();
+
+		/**
+		 * Returns the number of workers.
+		 * @return the number of workers
+		 */
+		inline unsigned int size() const { return (unsigned int) this->queues.size(); }
+
+		/**
+		 * Queues job and returns a future for its result. Waiting on the
+		 * future from inside a job ties up that worker; nested work should
+		 * use <code>parallelFor</code> instead.
+		 *
+		 * @param job a callable taking no arguments
+		 * @return a future for what job returns, or throws
+		 */
+		template <typename Job>
+		auto submit(Job job) -> std::future<decltype(job())> {
+			typedef decltype(job()) Result;
+			std::shared_ptr<std::packaged_task<Result()> > task(new std::packaged_task<Result()>(job));
+			std::future<Result> result = task->get_future();
+			enqueue([task]() { (*task)(); });
+			return result;
+		}
+
+		/**
+		 * Calls body(from, to) over consecutive chunks [from, to) of [begin,
+		 * end) of at most grain elements each, on the caller and up to
+		 * threads - 1 workers, and returns once every chunk is done. The
+		 * first exception thrown by body is rethrown here.
+		 *
+		 * @param begin the start of the range
+		 * @param end the end of the range
+		 * @param grain the largest chunk
+		 * @param body a callable taking (size_t, size_t)
+		 * @param threads the most threads to use, the caller included (0 = all workers)
+		 */
+		template <typename Body>
+		void parallelFor(size_t begin, size_t end, size_t grain, Body body, unsigned int threads = 0) {
+			if (begin >= end)
+				return;
+			grain = std::max<size_t>(grain, 1);
+			const size_t chunks = (end - begin + grain - 1) / grain;
+
+			size_t helpers = std::min<size_t>(chunks, threads == 0 ? size() + 1 : threads) - 1;
+			helpers = std::min<size_t>(helpers, size());
+			if (helpers == 0) {
+				body(begin, end);
+				return;
+			}
+
+			std::atomic<size_t> next(0);
+			std::atomic<size_t> finished(0);
+			std::exception_ptr failure;
+			std::mutex failureMutex;
+
+			auto drain = [&]() {
+				try {
+					for (size_t c = next.fetch_add(1); c < chunks; c = next.fetch_add(1))
+						body(begin + c * grain, std::min(end, begin + (c + 1) * grain));
+				}
+				catch (...) {
+					std::lock_guard<std::mutex> lock(failureMutex);
+					if (!failure)
+						failure = std::current_exception();
+					next.store(chunks);			// skip the chunks not yet started
+				}
+			};
+
+			for (size_t h = 0; h < helpers; ++h)
+				enqueue([&]() {
+					drain();
+					finished.fetch_add(1, std::memory_order_release);
+				});
+			drain();
+
+			// the helpers live on this stack frame, so wait for all of them
+			while (finished.load(std::memory_order_acquire) < helpers)
+				if (!runOne())
+					std::this_thread::yield();
+
+			if (failure)
+				std::rethrow_exception(failure);
+		}
+
+	private:
+		struct Queue {
+			std::mutex mutex;
+			std::deque<std::function<void()> > jobs;
+		};
+
+		std::vector<Queue*> queues;				// queues[i] belongs to worker i
+		std::vector<std::thread> workers;
+		std::atomic<size_t> pending;			// jobs queued and not yet taken
+		std::atomic<unsigned int> nextQueue;	// where the next job from outside goes
+		std::mutex sleepMutex;
+		std::condition_variable wake;
+		bool stopping;
+
+		void enqueue(std::function<void()> job);
+
+		/**
+		 * Runs one queued job on the calling thread, its own queue first
+		 * @return <code>false</code> if there was none
+		 */
+		bool runOne();
+
+		void work(unsigned int index);
+
+		/**
+		 * Returns the index of the calling thread among this pool's workers, or -1
+		 */
+		int self() const;
+
+		ThreadPool(const ThreadPool&);
+		ThreadPool& operator=(const ThreadPool&);
+	};
+}
+
+#endif /* THREADPOOL_H_ */
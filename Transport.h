@@ -0,0 +1,116 @@
+#ifndef TRANSPORT_H_
+#define TRANSPORT_H_
+
+#include <vector>
+#include <cstring>
+#include <cerrno>
+
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace Algorithms
+{
+	/**
+	 * The {@code Transport} interface carries messages between the processes
+	 * of a <code>PartitionedMST</code>. Rank 0 is the coordinator and ranks
+	 * 1 to size() - 1 are the workers. Only coordinator-worker links are
+	 * used.
+	 *
+	 * A transport is created by the coordinator before it forks the
+	 * workers, and records the pid of each one with <code>setProcess</code>
+	 * right after fork(), so that a blocked coordinator can tell a worker
+	 * that is slow from one that has died, even before it attached. Each
+	 * process then calls <code>attach</code> with its own rank before
+	 * sending or receiving anything.
+	 *
+	 * @programmer Richard Caaya
+	 */
+	class Transport
+	{
+	public:
+
+		/**
+		 * Records the calling process as the coordinator.
+		 */
+		Transport() : processes(1, getpid()) {}
+
+		virtual ~Transport() {}
+
+		/**
+		 * Records the pid of the worker process of rank. Called by the
+		 * coordinator right after fork().
+		 *
+		 * @param rank the worker's rank, 1 to size() - 1
+		 * @param pid the worker's process id
+		 */
+		virtual void setProcess(int rank, pid_t pid) {
+			if ((int) processes.size() <= rank)
+				processes.resize(rank + 1, 0);
+			processes[rank] = pid;
+		}
+
+		/**
+		 * Binds the calling process to rank.
+		 *
+		 * @param rank 0 for the coordinator, 1 to size() - 1 for a worker
+		 */
+		virtual void attach(int rank) = 0;
+
+		/**
+		 * Returns the number of processes, coordinator included.
+		 *
+		 * @return the number of ranks
+		 */
+		virtual int size() const = 0;
+
+		/**
+		 * Sends a message, blocking until it has been handed off.
+		 *
+		 * @param to the destination rank
+		 * @param message the bytes to send
+		 * @throws <code>std::runtime_error</code> if the link fails
+		 */
+		virtual void send(int to, const std::vector<char>& message) = 0;
+
+		/**
+		 * Receives the next message from a rank, blocking until it arrives.
+		 *
+		 * @param from the source rank
+		 * @return the message
+		 * @throws <code>std::runtime_error</code> if the link fails
+		 */
+		virtual std::vector<char> receive(int from) = 0;
+
+	protected:
+
+		/**
+		 * Tells whether the process of rank is still running: a worker, if
+		 * the coordinator asks, or the coordinator, if a worker asks. A
+		 * worker whose pid was never recorded counts as running.
+		 *
+		 * @param rank the rank of the process
+		 * @return <code>false</code> if it has exited
+		 */
+		bool isRunning(int rank) const {
+			pid_t pid = (rank < (int) processes.size()) ? processes[rank] : 0;
+			if (pid == 0 || pid == getpid())
+				return true;
+
+			// a child that exited stays a zombie until reaped, so ask without reaping it
+			siginfo_t info;
+			memset(&info, 0, sizeof(info));
+			if (waitid(P_PID, pid, &info, WEXITED | WNOHANG | WNOWAIT) == 0)
+				return info.si_pid == 0;
+			if (pid == getppid())
+				return true;
+			return kill(pid, 0) == 0 || errno == EPERM;
+		}
+
+	private:
+		std::vector<pid_t> processes;		// processes[r] = pid of rank r, 0 if not known
+	};
+}
+
+#endif /* TRANSPORT_H_ */
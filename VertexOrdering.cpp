@@ -0,0 +1,116 @@
+/**
+ * VertexOrdering.cpp
+ *
+ *  Programmer: Richard Caaya
+ */
+
+#include "VertexOrdering.h"
+
+#include <algorithm>
+
+namespace Algorithms
+{
+	VertexOrdering::VertexOrdering(const Graph& graph, Strategy strategy) {
+		const int V = graph.getV();
+
+		// the orderings are defined on the undirected graph, so symmetrize the lists
+		std::vector<std::vector<int> > adj(V);
+		for (int x = 0; x < V; ++x) {
+			graph.forEachNeighbor(x, [&adj, x](int y, double) {
+				if (y == x)
+					return;
+				adj[x].push_back(y);
+				adj[y].push_back(x);
+			});
+		}
+		for (int x = 0; x < V; ++x) {
+			std::sort(adj[x].begin(), adj[x].end());
+			adj[x].erase(std::unique(adj[x].begin(), adj[x].end()), adj[x].end());
+		}
+
+		oldId.reserve(V);
+		switch (strategy) {
+		case REVERSE_CUTHILL_MCKEE:
+			breadthFirst(adj, true);
+			std::reverse(oldId.begin(), oldId.end());
+			break;
+		case BREADTH_FIRST:
+			breadthFirst(adj, false);
+			break;
+		case DEGREE_SORTED:
+			degreeSorted(adj);
+			break;
+		}
+
+		newId.resize(V);
+		for (int i = 0; i < V; ++i)
+			newId[oldId[i]] = i;
+	}
+
+	void VertexOrdering::apply(Graph& graph, unsigned int threads) const {
+		graph.relabel(newId, threads);
+	}
+
+	void VertexOrdering::breadthFirst(const std::vector<std::vector<int> >& adj, bool byDegree) {
+		const int V = adj.size();
+		std::vector<bool> visited(V);
+
+		// Cuthill-McKee starts every component from a vertex of minimum degree
+		std::vector<int> roots(V);
+		for (int v = 0; v < V; ++v)
+			roots[v] = v;
+		if (byDegree) {
+			std::stable_sort(roots.begin(), roots.end(), [&adj](int a, int b) {
+				return adj[a].size() < adj[b].size();
+			});
+		}
+
+		std::vector<int> frontier;
+		for (int root : roots) {
+			if (visited[root])
+				continue;
+
+			// oldId doubles as the BFS queue
+			size_t head = oldId.size();
+			visited[root] = true;
+			oldId.push_back(root);
+
+			while (head < oldId.size()) {
+				int v = oldId[head++];
+
+				frontier.clear();
+				for (int w : adj[v]) {
+					if (!visited[w]) {
+						visited[w] = true;
+						frontier.push_back(w);
+					}
+				}
+				if (byDegree) {
+					std::stable_sort(frontier.begin(), frontier.end(), [&adj](int a, int b) {
+						return adj[a].size() < adj[b].size();
+					});
+				}
+				oldId.insert(oldId.end(), frontier.begin(), frontier.end());
+			}
+		}
+	}
+
+	void VertexOrdering::degreeSorted(const std::vector<std::vector<int> >& adj) {
+		const int V = adj.size();
+
+		// counting sort by descending degree, ties kept in original order
+		size_t maxDegree = 0;
+		for (int v = 0; v < V; ++v)
+			maxDegree = std::max(maxDegree, adj[v].size());
+
+		std::vector<int> start(maxDegree + 2, 0);
+		for (int v = 0; v < V; ++v)
+			start[maxDegree - adj[v].size() + 1]++;
+		for (size_t d = 1; d < start.size(); ++d)
+			start[d] += start[d - 1];
+
+		oldId.resize(V);
+		for (int v = 0; v < V; ++v)
+			oldId[start[maxDegree - adj[v].size()]++] = v;
+	}
+}
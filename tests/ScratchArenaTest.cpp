@@ -0,0 +1,55 @@
+/**
+ * ScratchArenaTest.cpp
+ *
+ * Builds MSTs on ThreadPool workers and destroys them on the calling
+ * thread, which then holds the released buffers, and checks that its
+ * arena stays bounded. Build from the repository root with
+ *
+ *		g++ -std=c++11 -pthread -I. tests/ScratchArenaTest.cpp *.cpp
+ *
+ *  Programmer: Richard Caaya
+ */
+
+#include <cassert>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "Graph.h"
+#include "MST.h"
+#include "ScratchArena.h"
+#include "ThreadPool.h"
+
+using namespace Algorithms;
+
+int main() {
+	Graph graph(200, Graph::ADJACENCY_LISTS);
+	srand(1);
+	for (int i = 0; i < 2000; ++i) {
+		int x = rand() % 200, y = rand() % 200;
+		double w = rand() % 100;
+		if (x != y && graph.addEdge(x, y, w))
+			graph.addEdge(y, x, w);
+	}
+	const double cost = MST(graph).cost();
+
+	ScratchArena& arena = ScratchArena::local();
+	arena.clear();
+
+	for (int round = 0; round < 50; ++round) {
+		std::vector<std::future<std::shared_ptr<MST> > > results;
+		for (int i = 0; i < 16; ++i)
+			results.push_back(ThreadPool::shared().submit([&graph]() { return std::make_shared<MST>(graph); }));
+		for (std::future<std::shared_ptr<MST> >& result : results) {
+			std::shared_ptr<MST> mst = result.get();
+			assert(mst->cost() == cost);
+		}	// each MST is destroyed here, releasing its buffers into this thread's arena
+
+		assert(arena.size() <= 4 * SCRATCH_BUFFERS_PER_TYPE);	// edgeTo, distTo, marked and the heap
+	}
+
+	std::cout << "ScratchArenaTest passed: " << arena.size() << " buffers held" << std::endl;
+	return 0;
+}